@@ -0,0 +1,280 @@
+#ifndef _aggregatestack_h
+#define _aggregatestack_h
+
+#include <iostream>
+#include <utility>
+#include "Vector.h"
+
+using namespace std;
+
+/**
+*  Ready-made associative operations for the aggregate containers.  Any
+*  function object with <code>type operator()(const type&, const type&)</code>
+*  that is associative can be used instead.
+*/
+template <typename type>
+struct MinOp {
+    type operator()(const type& a, const type& b) const {
+        return b < a ? b : a;
+    }
+};
+
+template <typename type>
+struct MaxOp {
+    type operator()(const type& a, const type& b) const {
+        return a < b ? b : a;
+    }
+};
+
+template <typename type>
+struct SumOp {
+    type operator()(const type& a, const type& b) const {
+        return a + b;
+    }
+};
+
+/**
+ * This class models a stack that also keeps the running aggregate of
+ * everything below each element.  With <code>MinOp</code> the top
+ * aggregate is the minimum of the stack, with <code>MaxOp</code> the
+ * maximum, with <code>SumOp</code> the sum, and so on.  Every element
+ * is stored next to the aggregate of itself and all elements under it,
+ * so <code>top_aggregate</code> is O(1) and <code>pop</code> never has
+ * to recompute anything.
+ */
+template <typename type, typename Op = SumOp<type> >
+class AggregateStack {
+public:
+    ///  constructors and destructor
+
+    /**
+    *  Initializes a new empty stack that combines values with <code>op</code>.
+    */
+    AggregateStack(Op op = Op()) : _op(op) { }
+
+    /**
+    *  Frees any heap storage associated with this stack.
+    */
+    virtual ~AggregateStack() = default;
+
+    ///  member function (methods)
+
+    /**
+    *  Pushes the specified value onto the top of this stack.
+    */
+    void push(const type& value) {
+        if (_values.empty())
+            _aggregates.push_back(value);
+        else
+            _aggregates.push_back(_op(_aggregates.back(), value));
+        _values.push_back(value);
+    }
+
+    /**
+    *  Removes the top element from this stack and returns it.
+    *  @throw "Exception" if stack is empty
+    */
+    type pop() {
+        if (empty())
+            throw "Exception :-(";
+        type value;
+        type aggregate;
+        _values.pop_back(&value, 1);
+        _aggregates.pop_back(&aggregate, 1);
+        return value;
+    }
+
+    /**
+    *  Returns the value of top element from this stack, without removing it.
+    *  @throw "Exception" if stack is empty
+    */
+    const type& peek() const {
+        if (empty())
+            throw "Exception :-(";
+        return _values.back();
+    }
+
+    /**
+    *  Returns the aggregate of every element in this stack, combined from
+    *  the bottom up.
+    *  @throw "Exception" if stack is empty
+    */
+    const type& top_aggregate() const {
+        if (empty())
+            throw "Exception :-(";
+        return _aggregates.back();
+    }
+
+    /**
+    *  Removes all elements from this stack.
+    */
+    void clear() {
+        _values.clear();
+        _aggregates.clear();
+    }
+
+    /**
+    *  Returns <code>true</code> if this stack contains no elements.
+    */
+    bool empty() const {
+        return _values.empty();
+    }
+
+    /**
+    *  Returns the number of values in this stack.
+    */
+    int size() const {
+        return _values.size();
+    }
+
+    template <typename T, typename O>
+    friend ostream& operator<<(ostream& out, const AggregateStack<T, O>& stack);
+
+private:
+    // member variable (fields)
+    Vector<type> _values;
+    Vector<type> _aggregates;     // _aggregates[i] combines _values[0..i]
+    Op _op;
+};
+
+/**
+ * This class models a first-in/first-out queue with an O(1) aggregate of
+ * its contents, which is what a sliding-window minimum, maximum or sum
+ * needs.  It is built from two stacks: new values go on the back stack,
+ * and when the front stack runs dry the back stack is flipped onto it.
+ * Each value is moved once, so <code>dequeue</code> is amortized O(1).
+ * The operation only has to be associative; the aggregate always combines
+ * the values from the oldest to the newest.
+ */
+template <typename type, typename Op = SumOp<type> >
+class AggregateQueue {
+public:
+    ///  constructors and destructor
+
+    /**
+    *  Initializes a new empty queue that combines values with <code>op</code>.
+    */
+    AggregateQueue(Op op = Op()) : _op(op) { }
+
+    /**
+    *  Frees any heap storage associated with this queue.
+    */
+    virtual ~AggregateQueue() = default;
+
+    ///  member function (methods)
+
+    /**
+    *  Adds <code>value</code> to the back of the queue.
+    */
+    void enqueue(const type& value) {
+        if (_back.empty())
+            _backAggregates.push_back(value);
+        else
+            _backAggregates.push_back(_op(_backAggregates.back(), value));
+        _back.push_back(value);
+    }
+
+    /**
+    *  Removes and returns the first item in the queue.
+    *  @throw "Exception" for empty queue
+    */
+    type dequeue() {
+        if (empty())
+            throw "Exception :-(";
+        if (_front.empty())
+            flip();
+        type value;
+        type aggregate;
+        _front.pop_back(&value, 1);
+        _frontAggregates.pop_back(&aggregate, 1);
+        return value;
+    }
+
+    /**
+    *  Returns the first value in the queue, without removing it.
+    *  @throw "Exception" for empty queue
+    */
+    const type& front() {
+        if (empty())
+            throw "Exception :-(";
+        if (_front.empty())
+            flip();
+        return _front.back();
+    }
+
+    /**
+    *  Returns the aggregate of every value in the queue, combined from the
+    *  oldest to the newest.
+    *  @throw "Exception" for empty queue
+    */
+    type aggregate() const {
+        if (empty())
+            throw "Exception :-(";
+        if (_front.empty())
+            return _backAggregates.back();
+        if (_back.empty())
+            return _frontAggregates.back();
+        return _op(_frontAggregates.back(), _backAggregates.back());
+    }
+
+    /**
+    *  Removes all elements from the queue.
+    */
+    void clear() {
+        _front.clear();
+        _frontAggregates.clear();
+        _back.clear();
+        _backAggregates.clear();
+    }
+
+    /**
+    *  Returns <code>true</code> if the queue contains no elements.
+    */
+    bool empty() const {
+        return _front.empty() && _back.empty();
+    }
+
+    /**
+    *  Returns the number of values in the queue.
+    */
+    int size() const {
+        return _front.size() + _back.size();
+    }
+
+private:
+    /**
+    *  Moves the back stack onto the front stack, newest first, so the
+    *  oldest value ends on top.  Front aggregates combine each value with
+    *  the newer values under it.
+    */
+    void flip() {
+        while (!_back.empty()) {
+            type value;
+            type aggregate;
+            _back.pop_back(&value, 1);
+            _backAggregates.pop_back(&aggregate, 1);
+            if (_front.empty())
+                _frontAggregates.push_back(value);
+            else
+                _frontAggregates.push_back(_op(value, _frontAggregates.back()));
+            _front.push_back(std::move(value));
+        }
+    }
+
+    // member variable (fields)
+    Vector<type> _front;          // Oldest value on top
+    Vector<type> _frontAggregates;
+    Vector<type> _back;           // Newest value on top
+    Vector<type> _backAggregates;
+    Op _op;
+};
+
+
+template <typename type, typename Op>
+ostream& operator<<(ostream& out, const AggregateStack<type, Op>& stack) {
+    out << stack._values;
+    return out;
+}
+
+
+#endif // _aggregatestack_h
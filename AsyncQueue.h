@@ -0,0 +1,208 @@
+#ifndef _asyncqueue_h
+#define _asyncqueue_h
+
+#include <coroutine>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include "Vector.h"
+
+using namespace std;
+
+/**
+ * This class models a first-in/first-out queue for C++20 coroutines.
+ * <code>co_await queue.dequeue()</code> returns the next value at once if
+ * there is one, and otherwise suspends the coroutine until a later
+ * <code>enqueue</code> hands it a value.  A suspended consumer holds no
+ * thread; it costs only its coroutine frame, so thousands of idle
+ * consumers are cheap.
+ *
+ * Waiting consumers are served in the order they arrived.  They are
+ * resumed through the executor given to the constructor, so a value can
+ * be handed to a thread pool or an event loop.  Without an executor the
+ * consumer is resumed inline, on the thread that called enqueue.
+ *
+ * The queue is safe to use from several threads at once.
+ */
+template <typename type>
+class AsyncQueue {
+public:
+    /**
+    *  Resumes a suspended consumer, e.g. by posting it to a thread pool.
+    */
+    typedef function<void(coroutine_handle<>)> Executor;
+
+    /**
+    *  The awaitable returned by <code>dequeue</code>.  It lives in the
+    *  awaiting coroutine's frame and is linked into the queue's list of
+    *  waiters while suspended, so waiting allocates nothing.
+    */
+    class Awaiter {
+    public:
+        Awaiter(AsyncQueue& queue) : _queue(queue) { }
+
+        bool await_ready() const {
+            return false;
+        }
+
+        bool await_suspend(coroutine_handle<> handle) {
+            _handle = handle;
+            return !_queue.take(*this);
+        }
+
+        type await_resume() {
+            return std::move(_value);
+        }
+
+    private:
+        friend class AsyncQueue;
+
+        AsyncQueue& _queue;
+        coroutine_handle<> _handle;
+        type _value = type();
+        Awaiter* _next = nullptr;
+    };
+
+    ///  constructors and destructor
+
+    /**
+    *  Initializes a new empty queue whose consumers are resumed by
+    *  <code>executor</code>, or inline if it is empty.
+    */
+    AsyncQueue(Executor executor = nullptr) : _executor(executor) {
+        _headPos = 0;
+        _first = nullptr;
+        _last = nullptr;
+        _waiting = 0;
+    }
+
+    /**
+    *  Suspended consumers point into the queue, so it can not be copied.
+    */
+    AsyncQueue(const AsyncQueue& queue) = delete;
+    AsyncQueue& operator=(const AsyncQueue& queue) = delete;
+
+    /**
+    *  Frees any heap storage associated with this queue.  Consumers still
+    *  suspended on it are never resumed.
+    */
+    virtual ~AsyncQueue() = default;
+
+    ///  member function (methods)
+
+    /**
+    *  Adds <code>value</code> to the end of the queue, or hands it straight
+    *  to the longest waiting consumer and resumes that consumer.
+    */
+    void enqueue(const type& value) {
+        Awaiter* waiter = nullptr;
+        {
+            lock_guard<mutex> lock(_lock);
+            if (_first == nullptr) {
+                _tail.push_back(value);
+                return;
+            }
+            waiter = _first;
+            _first = waiter->_next;
+            if (_first == nullptr)
+                _last = nullptr;
+            _waiting--;
+            waiter->_value = value;
+        }
+        resume(waiter->_handle);
+    }
+
+    /**
+    *  Returns an awaitable for the first value in the queue:
+    *  <code>type value = co_await queue.dequeue();</code>
+    */
+    Awaiter dequeue() {
+        return Awaiter(*this);
+    }
+
+    /**
+    *  Removes the first value into <code>value</code> without waiting.
+    *  Returns <code>false</code> if the queue is empty.
+    */
+    bool try_dequeue(type& value) {
+        lock_guard<mutex> lock(_lock);
+        return pop(value);
+    }
+
+    /**
+    *  Returns the number of values in the queue.
+    */
+    int size() {
+        lock_guard<mutex> lock(_lock);
+        return _head.size() - _headPos + _tail.size();
+    }
+
+    /**
+    *  Returns <code>true</code> if the queue contains no values.
+    */
+    bool empty() {
+        return size() == 0;
+    }
+
+    /**
+    *  Returns the number of consumers suspended on the queue.
+    */
+    int waiting() {
+        lock_guard<mutex> lock(_lock);
+        return _waiting;
+    }
+
+private:
+    /**
+    *  Gives <code>waiter</code> the first value if there is one, or else
+    *  queues it as a waiter.  Returns <code>true</code> if it got a value.
+    */
+    bool take(Awaiter& waiter) {
+        lock_guard<mutex> lock(_lock);
+        if (pop(waiter._value))
+            return true;
+
+        if (_last == nullptr)
+            _first = &waiter;
+        else
+            _last->_next = &waiter;
+        _last = &waiter;
+        _waiting++;
+        return false;
+    }
+
+    /**
+    *  Removes the first value.  The caller holds the lock.
+    */
+    bool pop(type& value) {
+        if (_headPos == _head.size()) {
+            if (_tail.empty())
+                return false;
+            _head.clear();
+            _head.swap(_tail);
+            _headPos = 0;
+        }
+        value = std::move(_head[_headPos++]);
+        return true;
+    }
+
+    void resume(coroutine_handle<> handle) {
+        if (_executor)
+            _executor(handle);
+        else
+            handle.resume();
+    }
+
+    // member variable (fields)
+    Vector<type> _head;           // Oldest values, consumed from _headPos
+    Vector<type> _tail;           // Newest values
+    int _headPos;
+    Awaiter* _first;              // Longest waiting consumer
+    Awaiter* _last;
+    int _waiting;
+    Executor _executor;
+    mutex _lock;
+};
+
+
+#endif // _asyncqueue_h
@@ -0,0 +1,409 @@
+#ifndef _chunkedgrid_h
+#define _chunkedgrid_h
+
+#include <functional>
+#include <utility>
+#include "Vector.h"
+
+using namespace std;
+
+/**
+*  It is an unbounded Grid for worlds that grow in every direction.
+*
+*  Cells are stored in <code>size</code> x <code>size</code> chunks that
+*  are allocated on the first write and found through a hash on the chunk
+*  position, so any int row and column, negative ones included, is valid,
+*  and memory follows the area actually touched.  Unwritten cells read as
+*  the background value.
+*
+*  Chunks can be moved out of memory: with an <code>onEvict</code>
+*  callback set, <code>evict</code> hands a chunk's cells to the callback
+*  before freeing it, and with a limit set the least recently used chunks
+*  are evicted automatically.  When a missing chunk is needed again the
+*  <code>onLoad</code> callback is asked to fill it back in.  References
+*  into a chunk are valid until it is evicted.
+*/
+template <typename type, int size = 64>
+class ChunkedGrid {
+public:
+    static_assert(size > 0 && (size & (size - 1)) == 0,
+                  "ChunkedGrid size must be a power of two");
+
+    class Row;
+
+    /**
+    *  Called with a chunk's position and its size * size cells, row by
+    *  row, when a chunk that was written to is evicted.
+    */
+    typedef function<void(int chunkRow, int chunkCol, const type* cells)> EvictFn;
+
+    /**
+    *  Called with a chunk's position and its cells, preset to the
+    *  background, when a chunk that is not in memory is needed.  Returns
+    *  <code>true</code> if it filled the cells in.
+    */
+    typedef function<bool(int chunkRow, int chunkCol, type* cells)> LoadFn;
+
+    ///  constructors and destructor
+
+    /**
+    *  Initializes an empty ChunkedGrid whose cells read as
+    *  <code>background</code>.
+    */
+    ChunkedGrid(const type& background = type());
+
+    /**
+    *  Chunks are owned by one ChunkedGrid, so it can not be copied.
+    */
+    ChunkedGrid(const ChunkedGrid& grid) = delete;
+    ChunkedGrid& operator=(const ChunkedGrid& grid) = delete;
+
+    /**
+    *  Frees every chunk without calling <code>onEvict</code>; call
+    *  <code>evictAll</code> first to save them.
+    */
+    virtual ~ChunkedGrid();
+
+    ///  member function (methods)
+
+    /**
+    *  Returns the element at <code>row</code>/<code>col</code>, loading
+    *  its chunk if there is a loader.  Reading never allocates a chunk
+    *  that the loader does not fill.
+    */
+    type get(int row, int col);
+
+    /**
+    *  Replaces the element at <code>row</code>/<code>col</code>, allocating
+    *  or loading its chunk.
+    */
+    void set(int row, int col, const type& value);
+
+    /**
+    *  Returns the element at <code>row</code>/<code>col</code> for reading
+    *  and writing, allocating or loading its chunk.
+    */
+    type& at(int row, int col);
+
+    /**
+    *  Returns <code>true</code> if the chunk holding <code>row</code>/
+    *  <code>col</code> is in memory.
+    */
+    bool resident(int row, int col) const;
+
+    /**
+    *  Returns the number of chunks in memory.
+    */
+    int chunks() const;
+
+    /**
+    *  Calls <code>fn(chunkRow, chunkCol, cells)</code> for every chunk in
+    *  memory.  Chunk <code>(r, c)</code> covers rows <code>r * size</code>
+    *  up to <code>(r + 1) * size</code> and the same for columns.
+    */
+    template <typename Fn>
+    void forEachChunk(Fn fn) const;
+
+    /**
+    *  Sets the callbacks used to move chunks out of and back into memory.
+    */
+    void onEvict(EvictFn fn);
+    void onLoad(LoadFn fn);
+
+    /**
+    *  Keeps at most <code>chunks</code> chunks in memory, evicting the
+    *  least recently used ones when a new chunk is needed.  0 means no
+    *  limit.
+    */
+    void limit(int chunks);
+
+    /**
+    *  Evicts the chunk at chunk position <code>chunkRow</code>/
+    *  <code>chunkCol</code>, if it is in memory.
+    */
+    void evict(int chunkRow, int chunkCol);
+
+    /**
+    *  Evicts every chunk, e.g. to save the whole world.
+    */
+    void evictAll();
+
+    /**
+    *  Drops every chunk without calling <code>onEvict</code>, so every
+    *  cell reads as the background again.
+    */
+    void clear();
+
+    /**
+    *  Returns the chunk position holding a cell coordinate, rounding
+    *  towards minus infinity.
+    */
+    static int chunkOf(int coordinate);
+
+    /// Operator Overloading
+
+    /**
+    *  Overloads <code>[]</code> so that <code>grid[row][col]</code> works
+    *  like it does on a Grid, for any row and column.
+    */
+    Row operator[](int row);
+
+    class Row {
+    public:
+        Row(ChunkedGrid* grid, int row) : _grid(grid), _row(row) { }
+
+        type& operator[](int col) const {
+            return _grid->at(_row, col);
+        }
+
+    private:
+        ChunkedGrid* _grid;
+        int _row;
+    };
+
+private:
+    struct Chunk {
+        int row;                      // Chunk position
+        int col;
+        bool dirty;                   // Written since it was created or loaded
+        long long used;               // _clock at the last access
+        type cells[size * size];
+    };
+
+    /**
+    *  Returns the chunk at a chunk position, or <code>nullptr</code>.
+    */
+    Chunk* find(int chunkRow, int chunkCol) const;
+
+    /**
+    *  Returns the chunk at a chunk position, loading it or, when
+    *  <code>create</code> is true, allocating it if it is missing.
+    */
+    Chunk* fetch(int chunkRow, int chunkCol, bool create);
+
+    void insert(Chunk* chunk);
+    void remove(Chunk* chunk);
+    void drop(Chunk* chunk);          // Evict one chunk
+    int home(int chunkRow, int chunkCol) const;
+
+    static int local(int coordinate) {
+        return coordinate & (size - 1);
+    }
+
+    // member variable (fields)
+    Vector<Chunk*> _slots;        // Open-addressing hash table, nullptr when free
+    int _count;                   // Chunks in memory
+    int _limit;                   // Most chunks in memory, 0 for no limit
+    long long _clock;             // Access counter for least recently used
+    Chunk* _last;                 // Chunk of the previous access
+    type _background;
+    EvictFn _evict;
+    LoadFn _load;
+};
+
+template <typename type, int size>
+ChunkedGrid<type, size>::ChunkedGrid(const type& background)
+    : _slots(16, nullptr), _count(0), _limit(0), _clock(0), _last(nullptr), _background(background) { }
+
+template <typename type, int size>
+ChunkedGrid<type, size>::~ChunkedGrid() {
+    for (int i = 0; i < _slots.size(); i++)
+        delete _slots[i];
+}
+
+template <typename type, int size>
+int ChunkedGrid<type, size>::chunkOf(int coordinate) {
+    return coordinate >= 0 ? coordinate / size : -((-(coordinate + 1)) / size) - 1;
+}
+
+template <typename type, int size>
+int ChunkedGrid<type, size>::home(int chunkRow, int chunkCol) const {
+    unsigned long long key = ((unsigned long long)(unsigned)chunkRow << 32) | (unsigned)chunkCol;
+    unsigned long long hash = key * 0x9E3779B97F4A7C15ull;
+    return (int)((hash >> 32) & (unsigned)(_slots.size() - 1));
+}
+
+template <typename type, int size>
+typename ChunkedGrid<type, size>::Chunk* ChunkedGrid<type, size>::find(int chunkRow, int chunkCol) const {
+    if (_last != nullptr && _last->row == chunkRow && _last->col == chunkCol)
+        return _last;
+    int mask = _slots.size() - 1;
+    for (int i = home(chunkRow, chunkCol); _slots[i] != nullptr; i = (i + 1) & mask)
+        if (_slots[i]->row == chunkRow && _slots[i]->col == chunkCol)
+            return _slots[i];
+    return nullptr;
+}
+
+template <typename type, int size>
+void ChunkedGrid<type, size>::insert(Chunk* chunk) {
+    if (2 * (_count + 1) > _slots.size()) {          /// keep the table at most half full
+        Vector<Chunk*> old(2 * _slots.size(), nullptr);
+        _slots.swap(old);
+        _count = 0;
+        for (int i = 0; i < old.size(); i++)
+            if (old[i] != nullptr)
+                insert(old[i]);
+    }
+    int mask = _slots.size() - 1;
+    int i = home(chunk->row, chunk->col);
+    while (_slots[i] != nullptr)
+        i = (i + 1) & mask;
+    _slots[i] = chunk;
+    _count++;
+}
+
+/**
+*  Takes a chunk out of the table, shifting later entries of its probe run
+*  back so lookups never need tombstones.
+*/
+template <typename type, int size>
+void ChunkedGrid<type, size>::remove(Chunk* chunk) {
+    int mask = _slots.size() - 1;
+    int hole = home(chunk->row, chunk->col);
+    while (_slots[hole] != chunk)
+        hole = (hole + 1) & mask;
+
+    for (int j = (hole + 1) & mask; _slots[j] != nullptr; j = (j + 1) & mask) {
+        int k = home(_slots[j]->row, _slots[j]->col);
+        bool movable = hole <= j ? (k <= hole || k > j) : (k <= hole && k > j);
+        if (movable) {
+            _slots[hole] = _slots[j];
+            hole = j;
+        }
+    }
+    _slots[hole] = nullptr;
+    _count--;
+    if (_last == chunk)
+        _last = nullptr;
+}
+
+template <typename type, int size>
+void ChunkedGrid<type, size>::drop(Chunk* chunk) {
+    remove(chunk);
+    if (chunk->dirty && _evict)
+        _evict(chunk->row, chunk->col, chunk->cells);
+    delete chunk;
+}
+
+template <typename type, int size>
+typename ChunkedGrid<type, size>::Chunk* ChunkedGrid<type, size>::fetch(int chunkRow, int chunkCol, bool create) {
+    Chunk* chunk = find(chunkRow, chunkCol);
+    if (chunk == nullptr) {
+        if (!create && !_load)
+            return nullptr;
+
+        chunk = new Chunk();
+        chunk->row = chunkRow;
+        chunk->col = chunkCol;
+        chunk->dirty = false;
+        for (int i = 0; i < size * size; i++)
+            chunk->cells[i] = _background;
+        bool loaded = _load && _load(chunkRow, chunkCol, chunk->cells);
+        if (!loaded && !create) {
+            delete chunk;
+            return nullptr;
+        }
+
+        while (_limit > 0 && _count >= _limit) {     /// make room: evict the coldest chunk
+            Chunk* coldest = nullptr;
+            for (int i = 0; i < _slots.size(); i++)
+                if (_slots[i] != nullptr && (coldest == nullptr || _slots[i]->used < coldest->used))
+                    coldest = _slots[i];
+            drop(coldest);
+        }
+        insert(chunk);
+    }
+    chunk->used = ++_clock;
+    _last = chunk;
+    return chunk;
+}
+
+template <typename type, int size>
+type ChunkedGrid<type, size>::get(int row, int col) {
+    Chunk* chunk = fetch(chunkOf(row), chunkOf(col), false);
+    if (chunk == nullptr)
+        return _background;
+    return chunk->cells[local(row) * size + local(col)];
+}
+
+template <typename type, int size>
+void ChunkedGrid<type, size>::set(int row, int col, const type& value) {
+    at(row, col) = value;
+}
+
+template <typename type, int size>
+type& ChunkedGrid<type, size>::at(int row, int col) {
+    Chunk* chunk = fetch(chunkOf(row), chunkOf(col), true);
+    chunk->dirty = true;
+    return chunk->cells[local(row) * size + local(col)];
+}
+
+template <typename type, int size>
+bool ChunkedGrid<type, size>::resident(int row, int col) const {
+    return find(chunkOf(row), chunkOf(col)) != nullptr;
+}
+
+template <typename type, int size>
+int ChunkedGrid<type, size>::chunks() const {
+    return _count;
+}
+
+template <typename type, int size>
+template <typename Fn>
+void ChunkedGrid<type, size>::forEachChunk(Fn fn) const {
+    for (int i = 0; i < _slots.size(); i++)
+        if (_slots[i] != nullptr)
+            fn(_slots[i]->row, _slots[i]->col, (const type*)_slots[i]->cells);
+}
+
+template <typename type, int size>
+void ChunkedGrid<type, size>::onEvict(EvictFn fn) {
+    _evict = fn;
+}
+
+template <typename type, int size>
+void ChunkedGrid<type, size>::onLoad(LoadFn fn) {
+    _load = fn;
+}
+
+template <typename type, int size>
+void ChunkedGrid<type, size>::limit(int chunks) {
+    if (chunks < 0)
+        throw "Exception :-(";
+    _limit = chunks;
+}
+
+template <typename type, int size>
+void ChunkedGrid<type, size>::evict(int chunkRow, int chunkCol) {
+    Chunk* chunk = find(chunkRow, chunkCol);
+    if (chunk != nullptr)
+        drop(chunk);
+}
+
+template <typename type, int size>
+void ChunkedGrid<type, size>::evictAll() {
+    Vector<Chunk*> resident;
+    for (int i = 0; i < _slots.size(); i++)
+        if (_slots[i] != nullptr)
+            resident.push_back(_slots[i]);
+    for (int i = 0; i < resident.size(); i++)
+        drop(resident[i]);
+}
+
+template <typename type, int size>
+void ChunkedGrid<type, size>::clear() {
+    for (int i = 0; i < _slots.size(); i++) {
+        delete _slots[i];
+        _slots[i] = nullptr;
+    }
+    _count = 0;
+    _last = nullptr;
+}
+
+template <typename type, int size>
+typename ChunkedGrid<type, size>::Row ChunkedGrid<type, size>::operator[](int row) {
+    return Row(this, row);
+}
+
+
+#endif // _chunkedgrid_h
@@ -0,0 +1,201 @@
+#ifndef _concurrentstack_h
+#define _concurrentstack_h
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include "Vector.h"
+
+using namespace std;
+
+/**
+ * This class models a lock-free last-in/first-out stack (a Treiber stack)
+ * that any number of threads can push to and pop from at once.
+ *
+ * The top of the stack is a tagged pointer: a node address packed with a
+ * counter that changes on every update.  A thread whose view of the top
+ * is out of date therefore fails its compare-and-swap even if the same
+ * node has come back to the top in the meantime, which rules out the ABA
+ * problem.  Popped nodes are recycled through a second tagged free list
+ * and only deleted with the stack, so reading a node that another thread
+ * has just popped is always safe.
+ *
+ * On 64-bit targets the counter lives in the upper 16 bits of the
+ * address, which assumes the usual 48-bit user address space.
+ */
+template <typename type>
+class ConcurrentStack {
+public:
+    ///  constructors and destructor
+
+    /**
+    *  Initializes a new empty stack.
+    */
+    ConcurrentStack() {
+        _top.store(0);
+        _free.store(0);
+        _size.store(0);
+    }
+
+    /**
+    *  The stack is shared between threads by address, so it can not be
+    *  copied or moved.
+    */
+    ConcurrentStack(const ConcurrentStack& stack) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack& stack) = delete;
+
+    /**
+    *  Frees every node, in the stack and on the free list.  No other
+    *  thread may be using the stack.
+    */
+    virtual ~ConcurrentStack() {
+        destroy(node(_top.load()));
+        destroy(node(_free.load()));
+    }
+
+    ///  member function (methods)
+
+    /**
+    *  Pushes the specified value onto the top of this stack.
+    */
+    void push(const type& value) {
+        Node* fresh = acquire();
+        fresh->value = value;
+        pushChain(_top, fresh, fresh);
+        _size.fetch_add(1, memory_order_relaxed);
+    }
+
+    void push(type&& value) {
+        Node* fresh = acquire();
+        fresh->value = std::move(value);
+        pushChain(_top, fresh, fresh);
+        _size.fetch_add(1, memory_order_relaxed);
+    }
+
+    /**
+    *  Removes the top element and moves it into <code>value</code>.
+    *  Returns <code>false</code> if the stack is empty.
+    */
+    bool try_pop(type& value) {
+        Node* top = popNode(_top);
+        if (top == nullptr)
+            return false;
+        _size.fetch_sub(1, memory_order_relaxed);
+        value = std::move(top->value);
+        pushChain(_free, top, top);
+        return true;
+    }
+
+    /**
+    *  Detaches every element with a single atomic exchange of the top and
+    *  returns them in the order pop would, i.e. the old top first.
+    */
+    Vector<type> pop_all() {
+        uint64_t old = _top.load(memory_order_relaxed);
+        while (!_top.compare_exchange_weak(old, pack(nullptr, tag(old) + 1),
+                                           memory_order_acquire,
+                                           memory_order_relaxed)) { }
+
+        Vector<type> values;
+        Node* first = node(old);
+        Node* last = nullptr;
+        for (Node* n = first; n != nullptr; n = n->next.load(memory_order_relaxed)) {
+            values.push_back(std::move(n->value));
+            last = n;
+        }
+        _size.fetch_sub(values.size(), memory_order_relaxed);
+        if (first != nullptr)
+            pushChain(_free, first, last);
+        return values;
+    }
+
+    /**
+    *  Returns <code>true</code> if this stack contains no elements.  The
+    *  answer may be stale by the time it is used if other threads are active.
+    */
+    bool empty() const {
+        return node(_top.load(memory_order_acquire)) == nullptr;
+    }
+
+    /**
+    *  Returns the number of elements in this stack at some recent moment.
+    */
+    int size() const {
+        int size = _size.load(memory_order_relaxed);
+        return size > 0 ? size : 0;
+    }
+
+private:
+    struct Node {
+        type value;
+        atomic<Node*> next{nullptr};
+    };
+
+    static const int TAG_SHIFT = sizeof(void*) == 8 ? 48 : 32;
+    static const uint64_t POINTER_MASK = (uint64_t(1) << TAG_SHIFT) - 1;
+
+    static uint64_t pack(Node* n, uint64_t tag) {
+        return ((uint64_t)(uintptr_t)n & POINTER_MASK) | (tag << TAG_SHIFT);
+    }
+
+    static Node* node(uint64_t word) {
+        return (Node*)(uintptr_t)(word & POINTER_MASK);
+    }
+
+    static uint64_t tag(uint64_t word) {
+        return word >> TAG_SHIFT;
+    }
+
+    /**
+    *  Links the chain from <code>first</code> to <code>last</code> in on top
+    *  of <code>head</code>.
+    */
+    static void pushChain(atomic<uint64_t>& head, Node* first, Node* last) {
+        uint64_t old = head.load(memory_order_relaxed);
+        do {
+            last->next.store(node(old), memory_order_relaxed);
+        } while (!head.compare_exchange_weak(old, pack(first, tag(old) + 1),
+                                             memory_order_release,
+                                             memory_order_relaxed));
+    }
+
+    /**
+    *  Unlinks and returns the node on top of <code>head</code>, or
+    *  <code>nullptr</code> if there is none.
+    */
+    static Node* popNode(atomic<uint64_t>& head) {
+        uint64_t old = head.load(memory_order_acquire);
+        while (node(old) != nullptr) {
+            Node* next = node(old)->next.load(memory_order_relaxed);
+            if (head.compare_exchange_weak(old, pack(next, tag(old) + 1),
+                                           memory_order_acquire,
+                                           memory_order_acquire))
+                return node(old);
+        }
+        return nullptr;
+    }
+
+    /**
+    *  Returns a recycled node, or a new one if the free list is empty.
+    */
+    Node* acquire() {
+        Node* recycled = popNode(_free);
+        return recycled != nullptr ? recycled : new Node();
+    }
+
+    static void destroy(Node* n) {
+        while (n != nullptr) {
+            Node* trash = n;
+            n = n->next.load(memory_order_relaxed);
+            delete trash;
+        }
+    }
+
+    // member variable (fields)
+    atomic<uint64_t> _top;        // Tagged pointer to the top node
+    atomic<uint64_t> _free;       // Tagged pointer to the recycled nodes
+    atomic<int> _size;
+};
+
+
+#endif // _concurrentstack_h
@@ -2,15 +2,57 @@
 #define _grid_h
 
 #include <iostream>
+#include <utility>
+#include <initializer_list>
+#include <type_traits>
+#include "GridLayout.h"
+#include "GridTranspose.h"
+#include "GridView.h"
 
 using namespace std;
 
 /**
 *  It is 2D array with some more functionality
+*
+*  The elements live in one contiguous block, so a Grid costs a single
+*  allocation and whole-grid passes stream through memory.  The
+*  <code>Layout</code> decides where each cell sits in that block: the
+*  default is row-major, where row <code>r</code> starts
+*  <code>r * stride</code> elements in, and <code>TiledLayout&lt;N&gt;</code>
+*  stores N x N tiles contiguously for column and neighbourhood access,
+*  and <code>MortonLayout</code> stores cells in Z-order for square region
+*  queries (see GridLayout.h).  The API is the same for every layout.
+*
+*  The block can have room for more rows and columns than the Grid shows,
+*  set aside with <code>reserve</code>.  Cells keep their place in the
+*  block when the Grid is resized within that room, so growing and
+*  shrinking move nothing; only when the room runs out is the block
+*  reallocated.
+*
+*  With <code>trackDirty</code> on, the Grid remembers which tiles were
+*  written since the last <code>clearDirty</code>, so incremental passes
+*  only revisit those.  <code>set</code> marks a single tile, and so does
+*  assigning through the cell proxy that <code>operator[]</code> hands out
+*  for non row-major layouts, which reads without marking.  A row pointer
+*  from a row-major <code>operator[]</code>, <code>data()</code> and a
+*  view can not tell reads from writes, so they mark every tile they
+*  reach even when they are only read through; read through a const Grid
+*  to keep tiles clean.  Marking is not thread-safe: take a view on one
+*  thread and hand its sub-views to the others.
 */
-template <typename type>
+template <typename type, typename Layout = RowMajorLayout>
 class Grid {
 public:
+    class Row;
+    class ConstRow;
+
+    /**
+    *  What <code>operator[]</code> returns: a plain pointer to the row when
+    *  the layout keeps rows contiguous, otherwise a small proxy object that
+    *  supports <code>[col]</code>.
+    */
+    typedef typename conditional<Layout::contiguousRows, type*, Row>::type RowType;
+    typedef typename conditional<Layout::contiguousRows, const type*, ConstRow>::type ConstRowType;
 
     /**
     *  Initializes a new Grid.
@@ -37,8 +79,8 @@ public:
     *  Copy Constructor - Deep Copy
     *  Take Constructor - Sallow Copy
     */
-    Grid(Grid& grid);       ///Copy Constructor
-    Grid(Grid&& grid);      ///Take Constructor
+    Grid(const Grid& grid);     ///Copy Constructor
+    Grid(Grid&& grid);          ///Take Constructor
 
     /**
     *  Frees any heap storage associated with this Grid.
@@ -69,7 +111,7 @@ public:
     *  values as the given other Grid.
     *  Identical in behavior to the == operator.
     */
-    bool equals(const Grid<type>& Grid) const;
+    bool equals(const Grid& grid) const;
 
     /**
     *  Stores the given value in every cell of this Grid.
@@ -128,9 +170,39 @@ public:
     *  and columns.  If the <code>retain</code> parameter is true,
     *  the previous Grid contents are retained as much as possible.
     *  If <code>retain</code> is not passed or is false, any previous Grid contents
-    *  are discarded.
+    *  are discarded.  Within the reserved room nothing is reallocated or
+    *  moved: cells that fall outside the Grid are just reset.
     */
     void resize(int row, int column, bool retain = false);
+
+    /**
+    *  Makes room in the block for at least <code>row</code> rows and
+    *  <code>column</code> columns, so that resizing up to that stays in
+    *  place.  The room never shrinks here, and the Grid keeps its shape
+    *  and contents.
+    */
+    void reserve(int row, int column);
+
+    /**
+    *  Returns the rows and columns the block has room for.
+    */
+    int rowCapacity() const;
+    int colCapacity() const;
+
+    /**
+    *  Gives up the room beyond the Grid's shape, and any reservation.
+    */
+    void shrinkToFit();
+
+    /**
+    *  Turns the Grid into its transpose, so that row <code>r</code> becomes
+    *  column <code>r</code>.  A square row-major Grid is transposed in
+    *  place when its reserved room is square too; any other Grid is copied
+    *  into a fresh block.  Row-major Grids are walked with cache-oblivious
+    *  blocking (see GridTranspose.h).  The reserved room is turned with
+    *  the Grid.
+    */
+    void transpose();
 
     /**
     *  Return the element at  <code>row</code>/<code>col</code>
@@ -151,14 +223,80 @@ public:
     */
     int size() const;
 
+    /**
+    *  Returns the distance, in elements, between the starts of two
+    *  consecutive rows.  Only row-major Grids have a stride.
+    */
+    int stride() const;
+
+    /**
+    *  Returns the block holding the elements, in layout order, or
+    *  <code>nullptr</code> for an empty Grid.  The non-const block can be
+    *  written anywhere, so it marks every tile dirty.
+    */
+    type* data();
+    const type* data() const;
+
+    /**
+    *  Returns the layout mapping cells to offsets in <code>data()</code>.
+    */
+    const Layout& layout() const;
+
+    /**
+    *  Calls <code>fn(row, col, rows, cols)</code> for every square tile of
+    *  <code>Layout::tile</code> cells a side, tile row by tile row, with
+    *  smaller tiles along the bottom and right edges.  For a tiled Grid
+    *  these are exactly the stored tiles, so a pass that works tile by
+    *  tile stays in cache.
+    */
+    template <typename Fn>
+    void forEachTile(Fn fn) const;
+
+    /**
+    *  Returns a view of the <code>rows</code> x <code>cols</code> rectangle
+    *  starting at <code>row</code>/<code>col</code>, which reads and
+    *  writes this Grid's cells in place (see GridView.h).
+    *  @throw "Exception" if the rectangle does not fit inside the Grid.
+    */
+    GridView<type, Layout> view(int row, int col, int rows, int cols);
+    GridView<const type, Layout> view(int row, int col, int rows, int cols) const;
+
+    /**
+    *  Turns dirty tracking on or off.  Tracking starts with every tile
+    *  clean, and stays on across assignment and resizing, which mark
+    *  every tile dirty.  On a row-major Grid the non-const
+    *  <code>operator[]</code> returns a plain row pointer, so it marks
+    *  the whole row even when it only reads: <code>sum += grid[r][c]</code>
+    *  on a non-const Grid dirties every tile.
+    */
+    void trackDirty(bool on = true);
+
+    /**
+    *  Returns <code>true</code> if the tile holding <code>row</code>/
+    *  <code>col</code> was written since the last <code>clearDirty</code>.
+    */
+    bool isDirty(int row, int col) const;
+
+    /**
+    *  Calls <code>fn(row, col, rows, cols)</code> for every dirty tile,
+    *  with the same tiles as <code>forEachTile</code>.
+    */
+    template <typename Fn>
+    void forEachDirtyTile(Fn fn) const;
+
+    /**
+    *  Marks every tile clean.
+    */
+    void clearDirty();
+
     /// Operator Overloading
 
     /**
     *  Copy Assignment Operator - Deep Copy
     *  Take Assignment Operator - Sallow Copy
     */
-    type& operator=(Grid& grid);       ///Copy Assignment
-    type& operator=(Grid&& grid);      ///Take Assignment
+    Grid& operator=(const Grid& grid);  ///Copy Assignment
+    Grid& operator=(Grid&& grid);       ///Take Assignment
 
     /**
     *  Overloads <code>[]</code> to select elements from this Grid.
@@ -167,8 +305,8 @@ public:
     *  the <code>row</code> and <code>col</code> arguments are outside
     *  the Grid boundaries.
     */
-    type* operator[](int row);
-    const type* operator[](int row) const;
+    RowType operator[](int row);
+    ConstRowType operator[](int row) const;
 
     /**
     *  Compares two Grids for equality.
@@ -190,378 +328,715 @@ public:
     bool operator>(const Grid& grid) const;
     bool operator>=(const Grid& grid) const;
 
-    template <typename T>
-    friend ostream& operator<<(ostream& out, Grid<T>& grid);
+    /**
+    *  The proxy for one cell returned by <code>grid[row][col]</code> for
+    *  layouts whose rows are not contiguous.  It reads through a
+    *  conversion and marks the cell's tile dirty only when it is assigned
+    *  to.  Use <code>get</code> to call a member of the element.
+    */
+    class Cell {
+    public:
+        Cell(Grid* grid, int row, int col) : _grid(grid), _row(row), _col(col) { }
+
+        operator const type&() const {
+            return element();
+        }
+
+        const type& get() const {
+            return element();
+        }
+
+        Cell& operator=(const type& value) {
+            write() = value;
+            return *this;
+        }
+
+        Cell& operator=(const Cell& cell) {
+            return *this = cell.element();
+        }
+
+        template <typename Value> Cell& operator+=(const Value& value) { write() += value; return *this; }
+        template <typename Value> Cell& operator-=(const Value& value) { write() -= value; return *this; }
+        template <typename Value> Cell& operator*=(const Value& value) { write() *= value; return *this; }
+        template <typename Value> Cell& operator/=(const Value& value) { write() /= value; return *this; }
+        template <typename Value> Cell& operator%=(const Value& value) { write() %= value; return *this; }
+        template <typename Value> Cell& operator&=(const Value& value) { write() &= value; return *this; }
+        template <typename Value> Cell& operator|=(const Value& value) { write() |= value; return *this; }
+        template <typename Value> Cell& operator^=(const Value& value) { write() ^= value; return *this; }
+        template <typename Value> Cell& operator<<=(const Value& value) { write() <<= value; return *this; }
+        template <typename Value> Cell& operator>>=(const Value& value) { write() >>= value; return *this; }
+
+        Cell& operator++() { ++write(); return *this; }
+        Cell& operator--() { --write(); return *this; }
+        type operator++(int) { return write()++; }
+        type operator--(int) { return write()--; }
+
+        bool operator==(const type& value) const {
+            return element() == value;
+        }
+
+        bool operator!=(const type& value) const {
+            return !(element() == value);
+        }
+
+    private:
+        const type& element() const {
+            return _grid->_elements[_grid->_layout.index(_row, _col)];
+        }
+
+        type& write() const {
+            _grid->markDirty(_row, _col, 1, 1);
+            return _grid->_elements[_grid->_layout.index(_row, _col)];
+        }
+
+        Grid* _grid;
+        int _row;
+        int _col;
+    };
+
+    /**
+    *  The row proxies returned by <code>operator[]</code> for layouts whose
+    *  rows are not contiguous.
+    */
+    class Row {
+    public:
+        Row(Grid* grid, int row) : _grid(grid), _row(row) { }
+
+        Cell operator[](int col) const {
+            return Cell(_grid, _row, col);
+        }
+
+    private:
+        Grid* _grid;
+        int _row;
+    };
+
+    class ConstRow {
+    public:
+        ConstRow(const Grid* grid, int row) : _grid(grid), _row(row) { }
+
+        const type& operator[](int col) const {
+            return _grid->_elements[_grid->_layout.index(_row, col)];
+        }
+
+    private:
+        const Grid* _grid;
+        int _row;
+    };
+
+    template <typename T, typename L>
+    friend ostream& operator<<(ostream& out, Grid<T, L>& grid);
 
-    template <typename T>
-    friend ostream& operator<<(ostream& out, const Grid<T>& grid);
+    template <typename T, typename L>
+    friend ostream& operator<<(ostream& out, const Grid<T, L>& grid);
 
 private:
+    /**
+    *  Applies <code>fn</code> to every element, one contiguous run at a
+    *  time in memory order, and compares elementwise in the same order.
+    */
+    template <typename Fn>
+    void apply(Fn fn);
+
+    template <typename Compare>
+    bool compare(const Grid& grid, Compare cmp) const;
+
+    /**
+    *  Gives the Grid an empty block for <code>row</code> x <code>column</code>.
+    */
+    void allocate(int row, int column);
+
+    /**
+    *  Moves the Grid to a new block with room for <code>row</code> x
+    *  <code>column</code> cells, keeping the cells that fit if
+    *  <code>retain</code> and otherwise leaving the Grid empty.
+    */
+    void relocate(int row, int column, bool retain);
+
+    /**
+    *  Gives a tracking Grid a clean dirty bitmap for its current shape, and
+    *  marks the tiles overlapping a rectangle dirty.
+    */
+    void shapeDirty();
+    void markDirty(int row, int col, int rows, int cols);
+    int dirtyWords() const;
+
     // member variable (fields)
-    type** _elements;
+    type* _elements;      // Block of _layout.capacity() elements
     int _row;             // The number of rows in the Grid
     int _column;          // The number of columns in the Grid
+    Layout _layout;       // Where each cell lives in _elements
+    int _reserveRows = 0;                   // The room asked for by reserve
+    int _reserveColumns = 0;
+    bool _tracking = false;                 // Whether writes mark _dirty
+    unsigned long long* _dirty = nullptr;   // One bit per tile, tile row by tile row
 };
 
-template <typename type>
-Grid<type>::Grid() {
+template <typename type, typename Layout>
+void Grid<type, Layout>::allocate(int row, int column) {
+    if (row < 0 || column < 0)
+        throw "Exception :-(";
+    _row = row;
+    _column = column;
+    _layout.shape(row, column);
+    _elements = _layout.capacity() > 0 ? new type[_layout.capacity()]() : nullptr;
+}
+
+template <typename type, typename Layout>
+Grid<type, Layout>::Grid() {
     _row = 0;
     _column = 0;
+    _layout.shape(0, 0);
     _elements = nullptr;
 }
 
-template <typename type>
-Grid<type>::Grid(int row, int column) {
-    _row = row;
-    _column = column;
-    _elements = new type*[row];
-    for (int i = 0; i < row; i++)
-        _elements[i] = new type[column]();
+template <typename type, typename Layout>
+Grid<type, Layout>::Grid(int row, int column) {
+    allocate(row, column);
 }
 
-template <typename type>
-Grid<type>::Grid(int row, int column, const type& value) {
-    _row = row;
-    _column = column;
-    _elements = new type*[row];
-    for (int i = 0; i < row; i++)
-        _elements[i] = new type[column];
-
-    for(int i = 0; i < row; i++)
-        for(int j = 0; j < column; j++)
-            _elements[i][j] = value;
+template <typename type, typename Layout>
+Grid<type, Layout>::Grid(int row, int column, const type& value) : Grid(row, column) {
+    fill(value);
 }
 
-template <typename type>
-Grid<type>::Grid(initializer_list<initializer_list<type> > list) {
-    _row = list.size();
-    if (list.begin() != list.end()) {
-        _column = list.begin()->size();
-    }
-    _elements = new type*[_row];
-    for (int i = 0; i < _row; i++)
-        _elements[i] = new type[_column];
+template <typename type, typename Layout>
+Grid<type, Layout>::Grid(initializer_list<initializer_list<type> > list) {
+    allocate(list.size(), list.begin() != list.end() ? list.begin()->size() : 0);
 
     auto rowItr = list.begin();
     for (int row = 0; row < _row; row++) {
         auto colItr = rowItr->begin();
         for (int col = 0; col < _column; col++) {
-            _elements[row][col] = *colItr;
+            _elements[_layout.index(row, col)] = *colItr;
             colItr++;
         }
         rowItr++;
     }
 }
 
-template <typename type>
-Grid<type>::Grid(Grid& grid) {
-    _row = grid._row;
-    _column = grid._column;
-    _elements = new type*[_row];
-    for (int i = 0; i < _row; i++)
-        _elements[i] = new type[_column];
-
-    for(int i = 0; i < _row; i++)
-        for(int j = 0; j < _column; j++)
-            _elements[i][j] = grid._elements[i][j];
+template <typename type, typename Layout>
+Grid<type, Layout>::Grid(const Grid& grid) {
+    allocate(grid._row, grid._column);
+    if (grid._tracking) {
+        trackDirty(true);
+        for (int i = 0; i < dirtyWords(); i++)
+            _dirty[i] = grid._dirty[i];
+    }
+    grid._layout.runs([this, &grid](int row, int col, int index, int length) {
+        type* target = _elements + _layout.index(row, col);
+        for (int k = 0; k < length; k++)
+            target[k] = grid._elements[index + k];
+    });
 }
 
-template <typename type>
-Grid<type>::Grid(Grid&& grid) {
+template <typename type, typename Layout>
+Grid<type, Layout>::Grid(Grid&& grid) {
     _row = grid._row;
     _column = grid._column;
+    _layout = grid._layout;
     _elements = grid._elements;
+    _reserveRows = grid._reserveRows;
+    _reserveColumns = grid._reserveColumns;
+    _tracking = grid._tracking;
+    _dirty = grid._dirty;
     grid._elements = nullptr;
+    grid._row = 0;
+    grid._column = 0;
+    grid._layout.shape(0, 0);
+    grid._reserveRows = 0;
+    grid._reserveColumns = 0;
+    grid._tracking = false;
+    grid._dirty = nullptr;
+}
+
+template <typename type, typename Layout>
+Grid<type, Layout>::~Grid() {
+    delete[] _elements;
+    delete[] _dirty;
 }
 
-template <typename type>
-Grid<type>::~Grid() {
-    _row = 0;
-    _column = 0;
-    for(int i = 0; i < _row; i++)
-        delete[] _elements[i];
-    delete[] _elements;
+template <typename type, typename Layout>
+type& Grid<type, Layout>::front() {
+    if(empty())
+        throw "Exception :-(";
+    markDirty(0, 0, 1, 1);
+    return _elements[_layout.index(0, 0)];
 }
 
-template <typename type>
-type& Grid<type>::front() {
+template <typename type, typename Layout>
+const type& Grid<type, Layout>::front() const {
     if(empty())
         throw "Exception :-(";
-    return _elements[0][0];
+    return _elements[_layout.index(0, 0)];
 }
 
-template <typename type>
-const type& Grid<type>::front() const {
+template <typename type, typename Layout>
+type& Grid<type, Layout>::back() {
     if(empty())
         throw "Exception :-(";
-    return _elements[0][0];
+    markDirty(_row - 1, _column - 1, 1, 1);
+    return _elements[_layout.index(_row - 1, _column - 1)];
 }
 
-template <typename type>
-type& Grid<type>::back() {
+template <typename type, typename Layout>
+const type& Grid<type, Layout>::back() const {
     if(empty())
         throw "Exception :-(";
-    return _elements[_row - 1][_column - 1];
+    return _elements[_layout.index(_row - 1, _column - 1)];
 }
 
-template <typename type>
-const type& Grid<type>::back() const {
-    if(empty())
-        throw "Exception :-(";
-    return _elements[_row - 1][_column - 1];
+template <typename type, typename Layout>
+template <typename Fn>
+void Grid<type, Layout>::apply(Fn fn) {
+    markDirty(0, 0, _row, _column);
+    type* elements = _elements;
+    _layout.runs([elements, &fn](int, int, int index, int length) {
+        type* run = elements + index;
+        for (int k = 0; k < length; k++)
+            fn(run[k]);
+    });
+}
+
+template <typename type, typename Layout>
+template <typename Compare>
+bool Grid<type, Layout>::compare(const Grid& grid, Compare cmp) const {
+    if (_row != grid._row || _column != grid._column)
+        return false;
+    bool same = true;
+    _layout.runs([this, &grid, &cmp, &same](int row, int col, int index, int length) {
+        const type* mine = _elements + index;
+        const type* theirs = grid._elements + grid._layout.index(row, col);
+        for (int k = 0; same && k < length; k++)
+            if (!cmp(mine[k], theirs[k]))
+                same = false;
+    });
+    return same;
 }
 
-template <typename type>
-void Grid<type>::clear() {
-    for(int i = 0; i < _row; i++)
-        for(int j = 0; j < _column; j++)
-            _elements[i][j] = type();
+template <typename type, typename Layout>
+void Grid<type, Layout>::clear() {
+    apply([](type& element) { element = type(); });
 }
 
-template <typename type>
-bool Grid<type>::equals(const Grid<type>& Grid) const {
-    for(int i = 0; i < _row; i++)
-        for(int j = 0; j < _column; j++)
-            if (_elements[i][j] != Grid._elements[i][j])
-                return false;
-    return true;
+template <typename type, typename Layout>
+bool Grid<type, Layout>::equals(const Grid& grid) const {
+    return compare(grid, [](const type& a, const type& b) { return a == b; });
 }
 
-template <typename type>
-void Grid<type>::fill(const type& value) {
-    for(int i = 0; i < _row; i++)
-        for(int j = 0; j < _column; j++)
-            _elements[i][j] = value;
+template <typename type, typename Layout>
+void Grid<type, Layout>::fill(const type& value) {
+    apply([&value](type& element) { element = value; });
 }
 
-template <typename type>
-type Grid<type>::get(int row, int col) const {
+template <typename type, typename Layout>
+type Grid<type, Layout>::get(int row, int col) const {
     if (!inBounds(row, col))
         throw "Exception :-(";
-    return _elements[row][col];
+    return _elements[_layout.index(row, col)];
 }
 
-template <typename type>
-int Grid<type>::height() const {
+template <typename type, typename Layout>
+int Grid<type, Layout>::height() const {
     return _row;
 }
 
-template <typename type>
-int Grid<type>::width() const {
+template <typename type, typename Layout>
+int Grid<type, Layout>::width() const {
     return _column;
 }
 
-template <typename type>
-bool Grid<type>::inBounds(int row, int col) const {
+template <typename type, typename Layout>
+bool Grid<type, Layout>::inBounds(int row, int col) const {
     return row >= 0 && col >= 0 && row < _row && col < _column;
 }
 
-template <typename type>
-bool Grid<type>::empty() const {
-    return _row == 0 && _column == 0;
+template <typename type, typename Layout>
+bool Grid<type, Layout>::empty() const {
+    return _row == 0 || _column == 0;
 }
 
-template <typename type>
-void Grid<type>::map(type (*fn)(type)) {
-    for(int i = 0; i < _row; i++)
-        for(int j = 0; j < _column; j++)
-            _elements[i][j] = fn(_elements[i][j]);
+template <typename type, typename Layout>
+void Grid<type, Layout>::map(type (*fn)(type)) {
+    apply([fn](type& element) { element = fn(element); });
 }
 
-template <typename type>
-void Grid<type>::map(type (*fn)(type&)) {
-    for(int i = 0; i < _row; i++)
-        for(int j = 0; j < _column; j++)
-            _elements[i][j] = fn(_elements[i][j]);
+template <typename type, typename Layout>
+void Grid<type, Layout>::map(type (*fn)(type&)) {
+    apply([fn](type& element) { element = fn(element); });
 }
 
-template <typename type>
-void Grid<type>::map(type (*fn)(const type&)) {
-    for(int i = 0; i < _row; i++)
-        for(int j = 0; j < _column; j++)
-            _elements[i][j] = fn(_elements[i][j]);
+template <typename type, typename Layout>
+void Grid<type, Layout>::map(type (*fn)(const type&)) {
+    apply([fn](type& element) { element = fn(element); });
 }
 
-template <typename type>
-int Grid<type>::numCols() const {
+template <typename type, typename Layout>
+int Grid<type, Layout>::numCols() const {
     return _column;
 }
 
-template <typename type>
-int Grid<type>::numRows() const {
+template <typename type, typename Layout>
+int Grid<type, Layout>::numRows() const {
     return _row;
 }
 
-template <typename type>
-void Grid<type>::resize(int row, int column, bool retain) {
-    type** temp = _elements;
-    int tempr = _row;
-    int tempc = _column;
+template <typename type, typename Layout>
+void Grid<type, Layout>::relocate(int row, int column, bool retain) {
+    Layout layout;
+    layout.reserve(row, column);
+    type* elements = layout.capacity() > 0 ? new type[layout.capacity()]() : nullptr;
+    layout.rows = retain ? (_row < row ? _row : row) : 0;
+    layout.cols = retain ? (_column < column ? _column : column) : 0;
+
+    if (retain) {
+        _layout.runs([this, elements, &layout](int r, int c, int index, int length) {
+            if (r >= layout.rows || c >= layout.cols)
+                return;
+            int count = layout.cols - c < length ? layout.cols - c : length;
+            for (int k = 0; k < count; k++)
+                elements[layout.index(r, c + k)] = std::move(_elements[index + k]);
+        });
+    }
+
+    delete[] _elements;
+    _elements = elements;
+    _layout = layout;
+    _row = layout.rows;
+    _column = layout.cols;
+}
+
+template <typename type, typename Layout>
+void Grid<type, Layout>::resize(int row, int column, bool retain) {
+    if (row < 0 || column < 0)
+        throw "Exception :-(";
+    if (row > _layout.reservedRows || column > _layout.reservedCols)
+        relocate(row > _reserveRows ? row : _reserveRows,
+                 column > _reserveColumns ? column : _reserveColumns, retain);
+
+    int keepRows = retain ? (_row < row ? _row : row) : 0;
+    int keepColumns = retain ? (_column < column ? _column : column) : 0;
+    for (int r = 0; r < _row; r++)              /// cells outside the shape stay default
+        for (int c = r < keepRows ? keepColumns : 0; c < _column; c++)
+            _elements[_layout.index(r, c)] = type();
 
     _row = row;
     _column = column;
-    _elements = new type*[row];
-    for (int i = 0; i < row; i++)
-        _elements[i] = new type[column]();
-
-    if(retain) {
-        int minCol = tempc > row ? row : tempc;
-        int minRow = tempr > column ? column : tempr;
-        for(int i = 0; i < minRow; i++)
-            for(int j = 0; j < minCol; j++)
-                _elements[i][j] = temp[i][j];
+    _layout.rows = row;
+    _layout.cols = column;
+    if (_tracking) {
+        shapeDirty();
+        markDirty(0, 0, _row, _column);
+    }
+}
+
+template <typename type, typename Layout>
+void Grid<type, Layout>::reserve(int row, int column) {
+    if (row < 0 || column < 0)
+        throw "Exception :-(";
+    _reserveRows = row > _reserveRows ? row : _reserveRows;
+    _reserveColumns = column > _reserveColumns ? column : _reserveColumns;
+    if (row <= _layout.reservedRows && column <= _layout.reservedCols)
+        return;
+    relocate(row > _layout.reservedRows ? row : _layout.reservedRows,
+             column > _layout.reservedCols ? column : _layout.reservedCols, true);
+}
+
+template <typename type, typename Layout>
+int Grid<type, Layout>::rowCapacity() const {
+    return _layout.reservedRows;
+}
+
+template <typename type, typename Layout>
+int Grid<type, Layout>::colCapacity() const {
+    return _layout.reservedCols;
+}
+
+template <typename type, typename Layout>
+void Grid<type, Layout>::shrinkToFit() {
+    _reserveRows = 0;
+    _reserveColumns = 0;
+    if (_row != _layout.reservedRows || _column != _layout.reservedCols)
+        relocate(_row, _column, true);
+}
+
+template <typename type, typename Layout>
+void Grid<type, Layout>::transpose() {
+    if constexpr (Layout::contiguousRows) {
+        if (_row == _column && _layout.reservedRows == _layout.reservedCols) {
+            transposeSquare(_elements, _layout.stride, _row);
+            std::swap(_reserveRows, _reserveColumns);
+            markDirty(0, 0, _row, _column);
+            return;
+        }
     }
 
-    for(int i = 0; i < tempr; i++)
-        delete[] temp[i];
-    delete[] temp;
+    Grid result;                                /// keep the reserved room, turned
+    result.relocate(_layout.reservedCols, _layout.reservedRows, false);
+    result._reserveRows = _reserveColumns;
+    result._reserveColumns = _reserveRows;
+    result.resize(_column, _row);
+    if constexpr (Layout::contiguousRows) {
+        if (!empty())
+            transposeCopy<type>(_elements, _layout.stride,
+                                result._elements, result._layout.stride, _row, _column);
+    } else {
+        _layout.runs([this, &result](int row, int col, int index, int length) {
+            for (int k = 0; k < length; k++)
+                result._elements[result._layout.index(col + k, row)] = std::move(_elements[index + k]);
+        });
+    }
+    *this = std::move(result);
 }
 
-template <typename type>
-type Grid<type>::at(int row, int col) const {
+template <typename type, typename Layout>
+type Grid<type, Layout>::at(int row, int col) const {
     if(!inBounds(row, col))
         throw "Exception :-(";
-    return _elements[row][col];
+    return _elements[_layout.index(row, col)];
 }
 
-template <typename type>
-void Grid<type>::set(int row, int col, const type& value) {
+template <typename type, typename Layout>
+void Grid<type, Layout>::set(int row, int col, const type& value) {
     if(!inBounds(row, col))
         throw "Exception :-(";
-    _elements[row][col] = value;
+    markDirty(row, col, 1, 1);
+    _elements[_layout.index(row, col)] = value;
 }
 
-template <typename type>
-int Grid<type>::size() const {
+template <typename type, typename Layout>
+int Grid<type, Layout>::size() const {
     return _row * _column;
 }
 
-template <typename type>
-type& Grid<type>::operator=(Grid& grid) {
-    _row = grid._row;
-    _column = grid._column;
-    _elements = new type*[_row];
-    for (int i = 0; i < _row; i++)
-        _elements[i] = new type[_column];
-
-    for(int i = 0; i < _row; i++)
-        for(int j = 0; j < _column; j++)
-            _elements[i][j] = grid._elements[i][j];
+template <typename type, typename Layout>
+int Grid<type, Layout>::stride() const {
+    return _layout.stride;
 }
 
-template <typename type>
-type& Grid<type>::operator=(Grid&& grid) {
-    _row = grid._row;
-    _column = grid._column;
-    _elements = grid._elements;
-    grid._elements = nullptr;
+template <typename type, typename Layout>
+type* Grid<type, Layout>::data() {
+    markDirty(0, 0, _row, _column);
+    return _elements;
 }
 
-template <typename type>
-type* Grid<type>::operator[](int row) {
-    if(!(row < _row))
-        throw "Exception :-(";
-    return _elements[row];
+template <typename type, typename Layout>
+const type* Grid<type, Layout>::data() const {
+    return _elements;
 }
 
-template <typename type>
-const type* Grid<type>::operator[](int row) const {
-    if(!(row < _row))
-        throw "Exception :-(";
-    return _elements[row];
+template <typename type, typename Layout>
+const Layout& Grid<type, Layout>::layout() const {
+    return _layout;
+}
+
+template <typename type, typename Layout>
+template <typename Fn>
+void Grid<type, Layout>::forEachTile(Fn fn) const {
+    const int tile = Layout::tile;
+    for (int r0 = 0; r0 < _row; r0 += tile)
+        for (int c0 = 0; c0 < _column; c0 += tile)
+            fn(r0, c0, _row - r0 < tile ? _row - r0 : tile,
+                       _column - c0 < tile ? _column - c0 : tile);
+}
+
+template <typename type, typename Layout>
+int Grid<type, Layout>::dirtyWords() const {
+    const int tile = Layout::tile;
+    int tiles = (_row + tile - 1) / tile * ((_column + tile - 1) / tile);
+    return (tiles + 63) / 64;
 }
 
-template <typename type>
-bool Grid<type>::operator==(const Grid& grid) const {
+template <typename type, typename Layout>
+void Grid<type, Layout>::shapeDirty() {
+    delete[] _dirty;
+    _dirty = dirtyWords() > 0 ? new unsigned long long[dirtyWords()]() : nullptr;
+}
+
+template <typename type, typename Layout>
+void Grid<type, Layout>::markDirty(int row, int col, int rows, int cols) {
+    if (!_tracking || rows <= 0 || cols <= 0)
+        return;
+    const int tile = Layout::tile;
+    int across = (_column + tile - 1) / tile;
+    for (int tr = row / tile; tr <= (row + rows - 1) / tile; tr++) {
+        for (int tc = col / tile; tc <= (col + cols - 1) / tile; tc++) {
+            int bit = tr * across + tc;
+            _dirty[bit / 64] |= 1ull << (bit % 64);
+        }
+    }
+}
+
+template <typename type, typename Layout>
+void Grid<type, Layout>::trackDirty(bool on) {
+    _tracking = on;
+    delete[] _dirty;
+    _dirty = nullptr;
+    if (on)
+        shapeDirty();
+}
+
+template <typename type, typename Layout>
+bool Grid<type, Layout>::isDirty(int row, int col) const {
+    if (!_tracking || !inBounds(row, col))
+        return false;
+    const int tile = Layout::tile;
+    int bit = row / tile * ((_column + tile - 1) / tile) + col / tile;
+    return (_dirty[bit / 64] >> (bit % 64)) & 1;
+}
+
+template <typename type, typename Layout>
+template <typename Fn>
+void Grid<type, Layout>::forEachDirtyTile(Fn fn) const {
+    if (!_tracking)
+        return;
+    const int tile = Layout::tile;
+    int across = (_column + tile - 1) / tile;
+    int tiles = (_row + tile - 1) / tile * across;
+    for (int w = 0; w * 64 < tiles; w++) {
+        for (unsigned long long bits = _dirty[w]; bits != 0; bits &= bits - 1) {
+#if defined(__GNUC__)
+            int bit = w * 64 + __builtin_ctzll(bits);
+#else
+            int bit = w * 64;
+            while (((bits >> (bit - w * 64)) & 1) == 0)
+                bit++;
+#endif
+            int r0 = bit / across * tile;
+            int c0 = bit % across * tile;
+            fn(r0, c0, _row - r0 < tile ? _row - r0 : tile,
+                       _column - c0 < tile ? _column - c0 : tile);
+        }
+    }
+}
+
+template <typename type, typename Layout>
+void Grid<type, Layout>::clearDirty() {
+    if (!_tracking)
+        return;
+    for (int i = 0; i < dirtyWords(); i++)
+        _dirty[i] = 0;
+}
+
+template <typename type, typename Layout>
+GridView<type, Layout> Grid<type, Layout>::view(int row, int col, int rows, int cols) {
+    if (row < 0 || col < 0 || rows < 0 || cols < 0
+        || row + rows > _row || col + cols > _column)
+        throw "Exception :-(";
+    markDirty(row, col, rows, cols);
+    return GridView<type, Layout>(_elements, &_layout, row, col, rows, cols);
+}
+
+template <typename type, typename Layout>
+GridView<const type, Layout> Grid<type, Layout>::view(int row, int col, int rows, int cols) const {
+    if (row < 0 || col < 0 || rows < 0 || cols < 0
+        || row + rows > _row || col + cols > _column)
+        throw "Exception :-(";
+    return GridView<const type, Layout>(_elements, &_layout, row, col, rows, cols);
+}
+
+template <typename type, typename Layout>
+Grid<type, Layout>& Grid<type, Layout>::operator=(const Grid& grid) {
+    if (this != &grid) {
+        Grid copy(grid);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template <typename type, typename Layout>
+Grid<type, Layout>& Grid<type, Layout>::operator=(Grid&& grid) {
+    if (this != &grid) {
+        delete[] _elements;
+        _row = grid._row;
+        _column = grid._column;
+        _layout = grid._layout;
+        _elements = grid._elements;
+        _reserveRows = grid._reserveRows;
+        _reserveColumns = grid._reserveColumns;
+        grid._elements = nullptr;
+        grid._row = 0;
+        grid._column = 0;
+        grid._layout.shape(0, 0);
+        grid._reserveRows = 0;
+        grid._reserveColumns = 0;
+        if (_tracking) {                    /// tracking belongs to this Grid, not the value
+            shapeDirty();
+            markDirty(0, 0, _row, _column);
+        }
+    }
+    return *this;
+}
+
+template <typename type, typename Layout>
+typename Grid<type, Layout>::RowType Grid<type, Layout>::operator[](int row) {
+    if(row < 0 || !(row < _row))
+        throw "Exception :-(";
+    if constexpr (Layout::contiguousRows) {
+        markDirty(row, 0, 1, _column);
+        return _elements + _layout.index(row, 0);
+    } else {
+        return Row(this, row);
+    }
+}
+
+template <typename type, typename Layout>
+typename Grid<type, Layout>::ConstRowType Grid<type, Layout>::operator[](int row) const {
+    if(row < 0 || !(row < _row))
+        throw "Exception :-(";
+    if constexpr (Layout::contiguousRows)
+        return _elements + _layout.index(row, 0);
+    else
+        return ConstRow(this, row);
+}
+
+template <typename type, typename Layout>
+bool Grid<type, Layout>::operator==(const Grid& grid) const {
     return equals(grid);
 }
 
-template <typename type>
-bool Grid<type>::operator!=(const Grid& grid) const {
+template <typename type, typename Layout>
+bool Grid<type, Layout>::operator!=(const Grid& grid) const {
     return !equals(grid);
 }
 
 
-template <typename type>
-bool Grid<type>::operator<(const Grid& grid) const {
-    if (size() == grid.size()) {
-        for (int i = 0; i < _row; i++) {
-            for (int j = 0; j < _column; j++)
-                if (!(_elements[i][j] < grid._elements[i][j]))
-                    return false;
-        }
-        return true;
-    }
-    return false;
+template <typename type, typename Layout>
+bool Grid<type, Layout>::operator<(const Grid& grid) const {
+    return compare(grid, [](const type& a, const type& b) { return a < b; });
 }
 
-template <typename type>
-bool Grid<type>::operator<=(const Grid& grid) const {
-    if (size() == grid.size()) {
-        for (int i = 0; i < _row; i++) {
-            for (int j = 0; j < _column; j++)
-                if (!(_elements[i][j] <= grid._elements[i][j]))
-                    return false;
-        }
-        return true;
-    }
-    return false;
+template <typename type, typename Layout>
+bool Grid<type, Layout>::operator<=(const Grid& grid) const {
+    return compare(grid, [](const type& a, const type& b) { return a <= b; });
 }
 
-template <typename type>
-bool Grid<type>::operator>(const Grid& grid) const {
-    if (size() == grid.size()) {
-        for (int i = 0; i < _row; i++) {
-            for (int j = 0; j < _column; j++)
-                if (!(_elements[i][j] > grid._elements[i][j]))
-                    return false;
-        }
-        return true;
-    }
-    return false;
+template <typename type, typename Layout>
+bool Grid<type, Layout>::operator>(const Grid& grid) const {
+    return compare(grid, [](const type& a, const type& b) { return a > b; });
 }
 
-template <typename type>
-bool Grid<type>::operator>=(const Grid& grid) const {
-    if (size() == grid.size()) {
-        for (int i = 0; i < _row; i++) {
-            for (int j = 0; j < _column; j++)
-                if (!(_elements[i][j] >= grid._elements[i][j]))
-                    return false;
-        }
-        return true;
-    }
-    return false;
+template <typename type, typename Layout>
+bool Grid<type, Layout>::operator>=(const Grid& grid) const {
+    return compare(grid, [](const type& a, const type& b) { return a >= b; });
 }
 
-template <typename T>
-ostream& operator<<(ostream& out, Grid<T>& grid) {
-    out << "{ ";
-    for (int i = 0; i < grid._row; i++) {
-        out << "{ ";
-        for(int j = 0; j < grid._column; j++)
-            if (j == grid._column - 1)
-                out << grid._elements[i][j];
-            else
-                out << grid._elements[i][j] << ",";
-    out << " }";
-    if (i != grid._row - 1)
-        out << "," << endl << "  ";
-    }
-    out << " } ";
-    return out;
+template <typename T, typename L>
+ostream& operator<<(ostream& out, Grid<T, L>& grid) {
+    const Grid<T, L>& view = grid;
+    return out << view;
 }
 
-template <typename T>
-ostream& operator<<(ostream& out, const Grid<T>& grid) {
+template <typename T, typename L>
+ostream& operator<<(ostream& out, const Grid<T, L>& grid) {
     out << "{ ";
     for (int i = 0; i < grid._row; i++) {
         out << "{ ";
         for(int j = 0; j < grid._column; j++)
             if (j == grid._column - 1)
-                out << grid._elements[i][j];
+                out << grid._elements[grid._layout.index(i, j)];
             else
-                out << grid._elements[i][j] << ",";
+                out << grid._elements[grid._layout.index(i, j)] << ",";
     out << " }";
     if (i != grid._row - 1)
         out << "," << endl << "  ";
@@ -569,6 +1044,8 @@ ostream& operator<<(ostream& out, const Grid<T>& grid) {
     out << " } ";
     return out;
 }
+
+#include "GridBool.h"
 
 
 #endif // _grid_h
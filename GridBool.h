@@ -0,0 +1,1340 @@
+#ifndef _gridbool_h
+#define _gridbool_h
+
+#include <iostream>
+#include <cstdint>
+#include <initializer_list>
+#include "Grid.h"
+
+using namespace std;
+
+/**
+*  Grid&lt;bool&gt; packs its cells into bits, 64 cells per word, so an
+*  occupancy map takes an eighth of the memory of a byte per cell.  Each
+*  row starts on a fresh word and every bit outside the Grid's shape is
+*  kept clear, so <code>fill</code>, <code>count</code> and the bitwise
+*  operators work a whole word at a time.  As on Grid, <code>reserve</code>
+*  sets room aside so that resizing within it stays in place; the room is
+*  whole words per row, so <code>colCapacity</code> is a multiple of 64.
+*
+*  The API is Grid's, except that <code>operator[]</code> and views hand
+*  out a proxy <code>Reference</code> per cell instead of a
+*  <code>bool&amp;</code>, and the block is reached through
+*  <code>words()</code> and <code>wordsPerRow()</code>: there is no
+*  <code>data()</code>, <code>stride()</code> or <code>layout()</code>,
+*  since no <code>bool*</code> can point at a bit.  Tiles are 64 x 64
+*  cells, one word wide.  Only the default row-major layout is packed.
+*
+*  Dirty tracking works as it does on Grid.  A <code>Reference</code>
+*  marks its tile only when it is written through, so reading
+*  <code>grid[r][c]</code> keeps tiles clean; whole-Grid writes mark every
+*  tile, a view marks its rectangle and the non-const <code>words()</code>
+*  marks the whole Grid.
+*/
+template <>
+class GridView<bool, RowMajorLayout>;
+
+template <>
+class GridView<const bool, RowMajorLayout>;
+
+template <>
+class Grid<bool, RowMajorLayout> {
+public:
+    class Reference;
+    class Row;
+    class ConstRow;
+
+    typedef Row RowType;
+    typedef ConstRow ConstRowType;
+
+    /**
+    *  Side of the square tiles <code>forEachTile</code> walks.
+    */
+    static const int TILE = 64;
+
+    /**
+    *  Initializes a new Grid.
+    */
+    Grid();
+
+    /**
+    *  Initializes a new Grid with given numbers row and column, all false.
+    */
+    Grid(int row, int column);
+
+    /**
+    *  Initializes a new Grid with given numbers row and column having value
+    *  <code>value</code> in each elements.
+    */
+    Grid(int row, int column, bool value);
+
+    /**
+    *  This constructor uses an initializer list to set up the Grid.
+    */
+    Grid(std::initializer_list<std::initializer_list<bool> > list);
+
+    /**
+    *  Copy Constructor - Deep Copy
+    *  Take Constructor - Sallow Copy
+    */
+    Grid(const Grid& grid);     ///Copy Constructor
+    Grid(Grid&& grid);          ///Take Constructor
+
+    /**
+    *  Frees any heap storage associated with this Grid.
+    */
+    virtual ~Grid();
+
+    /**
+    *  Returns the first element in the Grid.
+    *  @throw "Exception" if the Grid is empty.
+    */
+    Reference front();
+    bool front() const;
+
+    /**
+    *  Returns the last element in the Grid.
+    *  @throw "Exception" if the Grid is empty.
+    */
+    Reference back();
+    bool back() const;
+
+    /**
+    *  Sets every cell to false.
+    */
+    void clear();
+
+    /**
+    *  Returns the number of true cells, one popcount per word.
+    */
+    int count() const;
+
+    /**
+    *  Returns <code>true</code> if this Grid contains exactly the same
+    *  values as the given other Grid.
+    *  Identical in behavior to the == operator.
+    */
+    bool equals(const Grid& grid) const;
+
+    /**
+    *  Stores the given value in every cell of this Grid, a word at a time.
+    */
+    void fill(bool value);
+
+    /**
+    *  Inverts every cell.
+    */
+    void flip();
+
+    /**
+    *  Returns the element at the specified <code>row</code>/<code>col</code>
+    *  position in this Grid.
+    *  @throw "Exception" if the <code>row</code> and <code>col</code>
+    *  arguments are outside the Grid boundaries.
+    */
+    bool get(int row, int col) const;
+
+    /**
+    *  Returns the Grid's height,i.e. the number of rows in the Grid.
+    */
+    int height() const;
+
+    /**
+    *  Returns the Grid's width,i.e. the number of columns in the Grid.
+    */
+    int width() const;
+
+    /**
+    *  Returns <code>true</code> if the specified row and column position
+    *  is inside the bounds of the Grid.
+    */
+    bool inBounds(int row, int col) const;
+
+    /**
+    *  Returns <code>true</code> if the Grid has 0 rows and/or 0 columns.
+    */
+    bool empty() const;
+
+    /**
+    *  Calls the specified function on each element of the Grid.  A bool
+    *  function can only be constant, the identity or negation, so this
+    *  works a word at a time.
+    */
+    void map(bool (*fn)(bool));
+    void map(bool (*fn)(bool&));
+    void map(bool (*fn)(const bool&));
+
+    /**
+    *  Returns the number of columns in the Grid.
+    */
+    int numCols() const;
+
+    /**
+    *  Returns the number of rows in the Grid.
+    *  This is equal to the Grid's height.
+    */
+    int numRows() const;
+
+    /**
+    *  Reinitializes the Grid to have the specified number of rows
+    *  and columns.  If the <code>retain</code> parameter is true,
+    *  the previous Grid contents are retained as much as possible.
+    *  Within the reserved room nothing is reallocated or moved: bits that
+    *  fall outside the Grid are just cleared.
+    */
+    void resize(int row, int column, bool retain = false);
+
+    /**
+    *  Makes room in the block for at least <code>row</code> rows and
+    *  <code>column</code> columns, so that resizing up to that stays in
+    *  place.  The room never shrinks here, and the Grid keeps its shape
+    *  and contents.
+    */
+    void reserve(int row, int column);
+
+    /**
+    *  Returns the rows and columns the block has room for.
+    */
+    int rowCapacity() const;
+    int colCapacity() const;
+
+    /**
+    *  Gives up the room beyond the Grid's shape, and any reservation.
+    */
+    void shrinkToFit();
+
+    /**
+    *  Turns the Grid into its transpose.  The reserved room is turned
+    *  with the Grid.
+    */
+    void transpose();
+
+    /**
+    *  Return the element at  <code>row</code>/<code>col</code>
+    *  Identical in behavior to get.
+    */
+    bool at(int row, int col) const;
+
+    /**
+    *  Replaces the element at the specified <code>row</code>/<code>col</code>
+    *  location in this Grid with a new value.
+    *  @throw "Exception" if the <code>row</code> and <code>col</code>
+    *  arguments are outside the Grid boundaries.
+    */
+    void set(int row, int col, bool value);
+
+    /**
+    *  Returns the total number of elements in the Grid (row * col)
+    */
+    int size() const;
+
+    /**
+    *  Returns the words holding the cells, row after row, and the number
+    *  of words from one row to the next, which counts the reserved room.
+    *  Bit <code>c % 64</code> of word <code>c / 64</code> of a row is
+    *  column <code>c</code>.
+    */
+    uint64_t* words();
+    const uint64_t* words() const;
+    int wordsPerRow() const;
+
+    /**
+    *  Calls <code>fn(row, col, rows, cols)</code> for every 64 x 64 tile,
+    *  tile row by tile row, with smaller tiles along the bottom and right
+    *  edges.  Each tile is one word of 64 rows.
+    */
+    template <typename Fn>
+    void forEachTile(Fn fn) const;
+
+    /**
+    *  Returns a view of the <code>rows</code> x <code>cols</code> rectangle
+    *  starting at <code>row</code>/<code>col</code>, which reads and
+    *  writes this Grid's bits in place.  Its <code>fill</code>,
+    *  <code>clear</code> and <code>map</code> work a word at a time.
+    *  @throw "Exception" if the rectangle does not fit inside the Grid.
+    */
+    GridView<bool, RowMajorLayout> view(int row, int col, int rows, int cols);
+    GridView<const bool, RowMajorLayout> view(int row, int col, int rows, int cols) const;
+
+    /**
+    *  Turns dirty tracking on or off.  Tracking starts with every tile
+    *  clean, and stays on across assignment and resizing, which mark
+    *  every tile dirty.
+    */
+    void trackDirty(bool on = true);
+
+    /**
+    *  Returns <code>true</code> if the tile holding <code>row</code>/
+    *  <code>col</code> was written since the last <code>clearDirty</code>.
+    */
+    bool isDirty(int row, int col) const;
+
+    /**
+    *  Calls <code>fn(row, col, rows, cols)</code> for every dirty tile,
+    *  with the same tiles as <code>forEachTile</code>.
+    */
+    template <typename Fn>
+    void forEachDirtyTile(Fn fn) const;
+
+    /**
+    *  Marks every tile clean.
+    */
+    void clearDirty();
+
+    /// Operator Overloading
+
+    /**
+    *  Copy Assignment Operator - Deep Copy
+    *  Take Assignment Operator - Sallow Copy
+    */
+    Grid& operator=(const Grid& grid);  ///Copy Assignment
+    Grid& operator=(Grid&& grid);       ///Take Assignment
+
+    /**
+    *  Overloads <code>[]</code> so that <code>grid[row][col]</code> reads
+    *  and writes cells through a proxy.
+    *  @throw "Exception" if <code>row</code> is outside the Grid.
+    */
+    Row operator[](int row);
+    ConstRow operator[](int row) const;
+
+    /**
+    *  Cellwise AND, OR and XOR of two Grids of the same shape, a word at
+    *  a time.
+    *  @throw "Exception" if the shapes differ.
+    */
+    Grid& operator&=(const Grid& grid);
+    Grid& operator|=(const Grid& grid);
+    Grid& operator^=(const Grid& grid);
+    Grid operator&(const Grid& grid) const;
+    Grid operator|(const Grid& grid) const;
+    Grid operator^(const Grid& grid) const;
+
+    /**
+    *  Returns the cellwise negation.
+    */
+    Grid operator~() const;
+
+    /**
+    *  Compares two Grids for equality.
+    */
+    bool operator==(const Grid& grid) const;
+    bool operator!=(const Grid& grid) const;
+
+    /**
+    *  Relational operators that hold when they hold for every pair of
+    *  cells, as for other Grids.
+    */
+    bool operator<(const Grid& grid) const;
+    bool operator<=(const Grid& grid) const;
+    bool operator>(const Grid& grid) const;
+    bool operator>=(const Grid& grid) const;
+
+    /**
+    *  The proxy for one cell: a word and the bit of the cell in it, and
+    *  for a tracking Grid the word and bit of its tile, set on writes.
+    */
+    class Reference {
+    public:
+        Reference(uint64_t* word, uint64_t bit, unsigned long long* dirty = nullptr,
+                  unsigned long long tile = 0)
+            : _word(word), _bit(bit), _dirty(dirty), _tile(tile) { }
+
+        operator bool() const {
+            return (*_word & _bit) != 0;
+        }
+
+        Reference& operator=(bool value) {
+            if (value)
+                *_word |= _bit;
+            else
+                *_word &= ~_bit;
+            mark();
+            return *this;
+        }
+
+        Reference& operator=(const Reference& other) {
+            return *this = (bool)other;
+        }
+
+        void flip() {
+            *_word ^= _bit;
+            mark();
+        }
+
+    private:
+        void mark() const {
+            if (_dirty != nullptr)
+                *_dirty |= _tile;
+        }
+
+        uint64_t* _word;
+        uint64_t _bit;
+        unsigned long long* _dirty;
+        unsigned long long _tile;
+    };
+
+    class Row {
+    public:
+        Row(uint64_t* words, unsigned long long* dirty = nullptr, int firstTile = 0)
+            : _words(words), _dirty(dirty), _firstTile(firstTile) { }
+
+        Reference operator[](int col) const {
+            if (_dirty == nullptr)
+                return Reference(_words + col / 64, uint64_t(1) << (col % 64));
+            int tile = _firstTile + col / 64;
+            return Reference(_words + col / 64, uint64_t(1) << (col % 64),
+                             _dirty + tile / 64, 1ull << (tile % 64));
+        }
+
+    private:
+        uint64_t* _words;
+        unsigned long long* _dirty;     // The Grid's dirty bitmap, if it tracks
+        int _firstTile;                 // Tile of column 0 of the row
+    };
+
+    class ConstRow {
+    public:
+        ConstRow(const uint64_t* words) : _words(words) { }
+
+        bool operator[](int col) const {
+            return (_words[col / 64] >> (col % 64)) & 1;
+        }
+
+    private:
+        const uint64_t* _words;
+    };
+
+    friend ostream& operator<<(ostream& out, const Grid& grid);
+
+private:
+    void allocate(int row, int column);
+
+    /**
+    *  Moves the cells into a fresh block with room for <code>row</code>
+    *  rows and <code>column</code> columns.  Without <code>retain</code>
+    *  the Grid comes out empty, and with it the cells that fit are kept.
+    */
+    void relocate(int row, int column, bool retain);
+
+    /**
+    *  Words of a row that hold cells of the Grid.
+    */
+    int usedWords() const;
+
+    /**
+    *  Bits of the last word of a row that are inside the Grid.
+    */
+    uint64_t lastMask() const;
+
+    /**
+    *  Applies <code>fn</code> to every pair of words of the two Grids.
+    *  @throw "Exception" if the shapes differ.
+    */
+    template <typename Fn>
+    void combine(const Grid& grid, Fn fn);
+
+    /**
+    *  Returns <code>true</code> if <code>fn(mine, theirs, mask)</code> is
+    *  true for every pair of words, where <code>mask</code> has the bits
+    *  inside the Grid.
+    */
+    template <typename Fn>
+    bool all(const Grid& grid, Fn fn) const;
+
+    /**
+    *  Gives a tracking Grid a clean dirty bitmap for its current shape, and
+    *  marks the tiles overlapping a rectangle dirty.  A tile is one word
+    *  wide, so a row of tiles has <code>tilesAcross()</code> bits.
+    */
+    void shapeDirty();
+    void markDirty(int row, int col, int rows, int cols);
+    int tilesAcross() const;
+    int dirtyWords() const;
+
+    // member variable (fields)
+    uint64_t* _words;     // _roomRows * _wordsPerRow words
+    int _row;             // The number of rows in the Grid
+    int _column;          // The number of columns in the Grid
+    int _wordsPerRow;     // Words from one row to the next
+    int _roomRows;        // Rows the block has room for
+    int _reserveRows = 0;                   // The room asked for by reserve
+    int _reserveColumns = 0;
+    bool _tracking = false;                 // Whether writes mark _dirty
+    unsigned long long* _dirty = nullptr;   // One bit per tile, tile row by tile row
+};
+
+/**
+*  A view of a rectangle of a Grid&lt;bool&gt;: the Grid's words, and the row
+*  and column where the window starts.  It has the API of GridView, with
+*  <code>Reference</code> proxies for cells.  Whole-view writes touch
+*  each word once, masked to the view's columns, so bands of rows can be
+*  written from different threads.
+*/
+template <>
+class GridView<bool, RowMajorLayout> {
+public:
+    typedef Grid<bool, RowMajorLayout>::Reference Reference;
+
+    class Row;
+
+    ///  constructors
+
+    /**
+    *  Initializes a view of the <code>rows</code> x <code>cols</code>
+    *  rectangle starting at <code>row</code>/<code>col</code> of the words
+    *  <code>words</code>, <code>wordsPerRow</code> to a row.  Grid::view
+    *  checks the rectangle before calling this.
+    */
+    GridView(uint64_t* words, int wordsPerRow, int row, int col, int rows, int cols)
+        : _words(words), _wordsPerRow(wordsPerRow), _row0(row), _col0(col), _rows(rows), _cols(cols) { }
+
+    ///  member function (methods)
+
+    /**
+    *  Returns the cell at <code>row</code>/<code>col</code> of this view.
+    *  @throw "Exception" if the position is outside the view.
+    */
+    Reference get(int row, int col) const {
+        if (!inBounds(row, col))
+            throw "Exception :-(";
+        return cell(row, col);
+    }
+
+    bool at(int row, int col) const {
+        return get(row, col);
+    }
+
+    void set(int row, int col, bool value) const {
+        get(row, col) = value;
+    }
+
+    /**
+    *  Stores the given value in every cell of the view.
+    */
+    void fill(bool value) const {
+        if (value)
+            apply([](uint64_t& word, uint64_t mask) { word |= mask; });
+        else
+            apply([](uint64_t& word, uint64_t mask) { word &= ~mask; });
+    }
+
+    void clear() const {
+        fill(false);
+    }
+
+    /**
+    *  Inverts every cell of the view.
+    */
+    void flip() const {
+        apply([](uint64_t& word, uint64_t mask) { word ^= mask; });
+    }
+
+    /**
+    *  Calls the specified function on each cell of the view.  A bool
+    *  function can only be constant, the identity or negation, so this
+    *  works a word at a time.
+    */
+    template <typename Fn>
+    void map(Fn fn) const {
+        bool cell = false;
+        bool whenFalse = fn(cell);
+        cell = true;
+        bool whenTrue = fn(cell);
+        if (whenFalse == whenTrue)
+            fill(whenTrue);
+        else if (whenFalse)
+            flip();
+    }
+
+    /**
+    *  Returns the view of the <code>rows</code> x <code>cols</code>
+    *  rectangle starting at <code>row</code>/<code>col</code> of this view.
+    *  @throw "Exception" if it does not fit inside this view.
+    */
+    GridView view(int row, int col, int rows, int cols) const {
+        if (row < 0 || col < 0 || rows < 0 || cols < 0
+            || row + rows > _rows || col + cols > _cols)
+            throw "Exception :-(";
+        return GridView(_words, _wordsPerRow, _row0 + row, _col0 + col, rows, cols);
+    }
+
+    bool inBounds(int row, int col) const {
+        return row >= 0 && col >= 0 && row < _rows && col < _cols;
+    }
+
+    bool empty() const {
+        return _rows == 0 || _cols == 0;
+    }
+
+    int numRows() const { return _rows; }
+    int numCols() const { return _cols; }
+    int height() const { return _rows; }
+    int width() const { return _cols; }
+    int size() const { return _rows * _cols; }
+    int rowOffset() const { return _row0; }
+    int colOffset() const { return _col0; }
+
+    /// Operator Overloading
+
+    /**
+    *  Overloads <code>[]</code> so that <code>view[row][col]</code> works
+    *  like it does on a Grid.
+    *  @throw "Exception" if <code>row</code> is outside the view.
+    */
+    Row operator[](int row) const {
+        if (row < 0 || !(row < _rows))
+            throw "Exception :-(";
+        return Row(this, row);
+    }
+
+    class Row {
+    public:
+        Row(const GridView* view, int row) : _view(view), _row(row) { }
+
+        Reference operator[](int col) const {
+            return _view->cell(_row, col);
+        }
+
+    private:
+        const GridView* _view;
+        int _row;
+    };
+
+    friend ostream& operator<<(ostream& out, const GridView& view) {
+        out << "{ ";
+        for (int i = 0; i < view._rows; i++) {
+            out << "{ ";
+            for (int j = 0; j < view._cols; j++)
+                if (j == view._cols - 1)
+                    out << (bool)view.cell(i, j);
+                else
+                    out << (bool)view.cell(i, j) << ",";
+            out << " }";
+            if (i != view._rows - 1)
+                out << "," << endl << "  ";
+        }
+        out << " } ";
+        return out;
+    }
+
+private:
+    Reference cell(int row, int col) const {
+        int c = _col0 + col;
+        return Reference(_words + (_row0 + row) * _wordsPerRow + c / 64, uint64_t(1) << (c % 64));
+    }
+
+    /**
+    *  Calls <code>fn(word, mask)</code> for every word the view covers,
+    *  row by row, where <code>mask</code> has the view's bits of it.
+    */
+    template <typename Fn>
+    void apply(Fn fn) const {
+        if (empty())
+            return;
+        int first = _col0 / 64;
+        int last = (_col0 + _cols - 1) / 64;
+        for (int r = 0; r < _rows; r++) {
+            uint64_t* row = _words + (_row0 + r) * _wordsPerRow;
+            for (int w = first; w <= last; w++) {
+                int low = w == first ? _col0 % 64 : 0;
+                int high = w == last ? (_col0 + _cols - 1) % 64 + 1 : 64;
+                uint64_t mask = (high == 64 ? ~uint64_t(0) : (uint64_t(1) << high) - 1)
+                              & ~((uint64_t(1) << low) - 1);
+                fn(row[w], mask);
+            }
+        }
+    }
+
+    // member variable (fields)
+    uint64_t* _words;         // The Grid's words
+    int _wordsPerRow;
+    int _row0;                // Grid row of the view's row 0
+    int _col0;                // Grid column of the view's column 0
+    int _rows;
+    int _cols;
+};
+
+/**
+*  The read-only view of a rectangle of a const Grid&lt;bool&gt;.
+*/
+template <>
+class GridView<const bool, RowMajorLayout> {
+public:
+    class Row;
+
+    GridView(const uint64_t* words, int wordsPerRow, int row, int col, int rows, int cols)
+        : _words(words), _wordsPerRow(wordsPerRow), _row0(row), _col0(col), _rows(rows), _cols(cols) { }
+
+    /**
+    *  Returns the cell at <code>row</code>/<code>col</code> of this view.
+    *  @throw "Exception" if the position is outside the view.
+    */
+    bool get(int row, int col) const {
+        if (!inBounds(row, col))
+            throw "Exception :-(";
+        return cell(row, col);
+    }
+
+    bool at(int row, int col) const {
+        return get(row, col);
+    }
+
+    GridView view(int row, int col, int rows, int cols) const {
+        if (row < 0 || col < 0 || rows < 0 || cols < 0
+            || row + rows > _rows || col + cols > _cols)
+            throw "Exception :-(";
+        return GridView(_words, _wordsPerRow, _row0 + row, _col0 + col, rows, cols);
+    }
+
+    bool inBounds(int row, int col) const {
+        return row >= 0 && col >= 0 && row < _rows && col < _cols;
+    }
+
+    bool empty() const {
+        return _rows == 0 || _cols == 0;
+    }
+
+    int numRows() const { return _rows; }
+    int numCols() const { return _cols; }
+    int height() const { return _rows; }
+    int width() const { return _cols; }
+    int size() const { return _rows * _cols; }
+    int rowOffset() const { return _row0; }
+    int colOffset() const { return _col0; }
+
+    Row operator[](int row) const {
+        if (row < 0 || !(row < _rows))
+            throw "Exception :-(";
+        return Row(this, row);
+    }
+
+    class Row {
+    public:
+        Row(const GridView* view, int row) : _view(view), _row(row) { }
+
+        bool operator[](int col) const {
+            return _view->cell(_row, col);
+        }
+
+    private:
+        const GridView* _view;
+        int _row;
+    };
+
+    friend ostream& operator<<(ostream& out, const GridView& view) {
+        out << "{ ";
+        for (int i = 0; i < view._rows; i++) {
+            out << "{ ";
+            for (int j = 0; j < view._cols; j++)
+                if (j == view._cols - 1)
+                    out << view.cell(i, j);
+                else
+                    out << view.cell(i, j) << ",";
+            out << " }";
+            if (i != view._rows - 1)
+                out << "," << endl << "  ";
+        }
+        out << " } ";
+        return out;
+    }
+
+private:
+    bool cell(int row, int col) const {
+        int c = _col0 + col;
+        return (_words[(_row0 + row) * _wordsPerRow + c / 64] >> (c % 64)) & 1;
+    }
+
+    // member variable (fields)
+    const uint64_t* _words;   // The Grid's words
+    int _wordsPerRow;
+    int _row0;
+    int _col0;
+    int _rows;
+    int _cols;
+};
+
+inline void Grid<bool, RowMajorLayout>::allocate(int row, int column) {
+    if (row < 0 || column < 0)
+        throw "Exception :-(";
+    _row = row;
+    _column = column;
+    _roomRows = row;
+    _wordsPerRow = (column + 63) / 64;
+    _words = row * _wordsPerRow > 0 ? new uint64_t[row * _wordsPerRow]() : nullptr;
+}
+
+inline void Grid<bool, RowMajorLayout>::relocate(int row, int column, bool retain) {
+    int wordsPerRow = (column + 63) / 64;
+    uint64_t* words = row * wordsPerRow > 0 ? new uint64_t[row * wordsPerRow]() : nullptr;
+    int rows = retain ? (_row < row ? _row : row) : 0;
+    int columns = retain ? (_column < column ? _column : column) : 0;
+
+    int keep = (columns + 63) / 64;
+    for (int r = 0; r < rows; r++)
+        for (int w = 0; w < keep; w++)
+            words[r * wordsPerRow + w] = _words[r * _wordsPerRow + w];
+
+    delete[] _words;
+    _words = words;
+    _wordsPerRow = wordsPerRow;
+    _roomRows = row;
+    _row = rows;
+    _column = columns;
+    if (keep > 0)                               /// clear the columns cut off
+        for (int r = 0; r < rows; r++)
+            _words[r * _wordsPerRow + keep - 1] &= lastMask();
+}
+
+inline int Grid<bool, RowMajorLayout>::usedWords() const {
+    return (_column + 63) / 64;
+}
+
+inline uint64_t Grid<bool, RowMajorLayout>::lastMask() const {
+    return _column % 64 == 0 ? ~uint64_t(0) : (uint64_t(1) << (_column % 64)) - 1;
+}
+
+inline Grid<bool, RowMajorLayout>::Grid() {
+    allocate(0, 0);
+}
+
+inline Grid<bool, RowMajorLayout>::Grid(int row, int column) {
+    allocate(row, column);
+}
+
+inline Grid<bool, RowMajorLayout>::Grid(int row, int column, bool value) : Grid(row, column) {
+    fill(value);
+}
+
+inline Grid<bool, RowMajorLayout>::Grid(initializer_list<initializer_list<bool> > list) {
+    allocate(list.size(), list.begin() != list.end() ? list.begin()->size() : 0);
+
+    auto rowItr = list.begin();
+    for (int row = 0; row < _row; row++) {
+        auto colItr = rowItr->begin();
+        for (int col = 0; col < _column; col++) {
+            (*this)[row][col] = *colItr;
+            colItr++;
+        }
+        rowItr++;
+    }
+}
+
+inline Grid<bool, RowMajorLayout>::Grid(const Grid& grid) {
+    allocate(grid._row, grid._column);
+    if (grid._tracking) {
+        trackDirty(true);
+        for (int i = 0; i < dirtyWords(); i++)
+            _dirty[i] = grid._dirty[i];
+    }
+    for (int r = 0; r < _row; r++)
+        for (int w = 0; w < _wordsPerRow; w++)
+            _words[r * _wordsPerRow + w] = grid._words[r * grid._wordsPerRow + w];
+}
+
+inline Grid<bool, RowMajorLayout>::Grid(Grid&& grid) {
+    _row = grid._row;
+    _column = grid._column;
+    _wordsPerRow = grid._wordsPerRow;
+    _words = grid._words;
+    _roomRows = grid._roomRows;
+    _reserveRows = grid._reserveRows;
+    _reserveColumns = grid._reserveColumns;
+    _tracking = grid._tracking;
+    _dirty = grid._dirty;
+    grid._words = nullptr;
+    grid._row = 0;
+    grid._column = 0;
+    grid._wordsPerRow = 0;
+    grid._roomRows = 0;
+    grid._reserveRows = 0;
+    grid._reserveColumns = 0;
+    grid._tracking = false;
+    grid._dirty = nullptr;
+}
+
+inline Grid<bool, RowMajorLayout>::~Grid() {
+    delete[] _words;
+    delete[] _dirty;
+}
+
+inline Grid<bool, RowMajorLayout>::Reference Grid<bool, RowMajorLayout>::front() {
+    if (empty())
+        throw "Exception :-(";
+    return (*this)[0][0];
+}
+
+inline bool Grid<bool, RowMajorLayout>::front() const {
+    if (empty())
+        throw "Exception :-(";
+    return get(0, 0);
+}
+
+inline Grid<bool, RowMajorLayout>::Reference Grid<bool, RowMajorLayout>::back() {
+    if (empty())
+        throw "Exception :-(";
+    return (*this)[_row - 1][_column - 1];
+}
+
+inline bool Grid<bool, RowMajorLayout>::back() const {
+    if (empty())
+        throw "Exception :-(";
+    return get(_row - 1, _column - 1);
+}
+
+inline void Grid<bool, RowMajorLayout>::clear() {
+    fill(false);
+}
+
+inline int Grid<bool, RowMajorLayout>::count() const {
+    int total = 0;
+    for (int i = 0; i < _row * _wordsPerRow; i++) {
+#if defined(__GNUC__)
+        total += __builtin_popcountll(_words[i]);
+#else
+        uint64_t word = _words[i];
+        for (; word != 0; word &= word - 1)
+            total++;
+#endif
+    }
+    return total;
+}
+
+inline bool Grid<bool, RowMajorLayout>::equals(const Grid& grid) const {
+    return all(grid, [](uint64_t a, uint64_t b, uint64_t mask) { return ((a ^ b) & mask) == 0; });
+}
+
+inline void Grid<bool, RowMajorLayout>::fill(bool value) {
+    if (empty())
+        return;
+    int used = usedWords();
+    uint64_t* word = _words;
+    for (int r = 0; r < _row; r++) {
+        for (int w = 0; w < used; w++)
+            word[w] = value ? ~uint64_t(0) : 0;
+        word[used - 1] &= lastMask();     /// keep the padding bits clear
+        word += _wordsPerRow;
+    }
+    markDirty(0, 0, _row, _column);
+}
+
+inline void Grid<bool, RowMajorLayout>::flip() {
+    if (empty())
+        return;
+    int used = usedWords();
+    uint64_t* word = _words;
+    for (int r = 0; r < _row; r++) {
+        for (int w = 0; w < used; w++)
+            word[w] = ~word[w];
+        word[used - 1] &= lastMask();
+        word += _wordsPerRow;
+    }
+    markDirty(0, 0, _row, _column);
+}
+
+inline bool Grid<bool, RowMajorLayout>::get(int row, int col) const {
+    if (!inBounds(row, col))
+        throw "Exception :-(";
+    return (*this)[row][col];
+}
+
+inline int Grid<bool, RowMajorLayout>::height() const {
+    return _row;
+}
+
+inline int Grid<bool, RowMajorLayout>::width() const {
+    return _column;
+}
+
+inline bool Grid<bool, RowMajorLayout>::inBounds(int row, int col) const {
+    return row >= 0 && col >= 0 && row < _row && col < _column;
+}
+
+inline bool Grid<bool, RowMajorLayout>::empty() const {
+    return _row == 0 || _column == 0;
+}
+
+inline void Grid<bool, RowMajorLayout>::map(bool (*fn)(bool)) {
+    bool whenFalse = fn(false);
+    bool whenTrue = fn(true);
+    if (whenFalse == whenTrue)
+        fill(whenTrue);
+    else if (whenFalse)
+        flip();
+}
+
+inline void Grid<bool, RowMajorLayout>::map(bool (*fn)(bool&)) {
+    bool cell = false;
+    bool whenFalse = fn(cell);
+    cell = true;
+    bool whenTrue = fn(cell);
+    if (whenFalse == whenTrue)
+        fill(whenTrue);
+    else if (whenFalse)
+        flip();
+}
+
+inline void Grid<bool, RowMajorLayout>::map(bool (*fn)(const bool&)) {
+    bool whenFalse = fn(false);
+    bool whenTrue = fn(true);
+    if (whenFalse == whenTrue)
+        fill(whenTrue);
+    else if (whenFalse)
+        flip();
+}
+
+inline int Grid<bool, RowMajorLayout>::numCols() const {
+    return _column;
+}
+
+inline int Grid<bool, RowMajorLayout>::numRows() const {
+    return _row;
+}
+
+inline void Grid<bool, RowMajorLayout>::resize(int row, int column, bool retain) {
+    if (row < 0 || column < 0)
+        throw "Exception :-(";
+    if (row > _roomRows || column > colCapacity())
+        relocate(row > _reserveRows ? row : _reserveRows,
+                 column > _reserveColumns ? column : _reserveColumns, retain);
+
+    int keepRows = retain ? (_row < row ? _row : row) : 0;
+    int keepColumns = retain ? (_column < column ? _column : column) : 0;
+    int used = usedWords();
+    for (int r = 0; r < _row; r++) {            /// bits outside the shape stay clear
+        uint64_t* word = _words + r * _wordsPerRow;
+        int first = r < keepRows ? keepColumns / 64 : 0;
+        if (r < keepRows && keepColumns % 64 != 0)
+            word[first++] &= (uint64_t(1) << (keepColumns % 64)) - 1;
+        for (int w = first; w < used; w++)
+            word[w] = 0;
+    }
+
+    _row = row;
+    _column = column;
+    if (_tracking) {
+        shapeDirty();
+        markDirty(0, 0, _row, _column);
+    }
+}
+
+inline void Grid<bool, RowMajorLayout>::reserve(int row, int column) {
+    if (row < 0 || column < 0)
+        throw "Exception :-(";
+    _reserveRows = row > _reserveRows ? row : _reserveRows;
+    _reserveColumns = column > _reserveColumns ? column : _reserveColumns;
+    if (row <= _roomRows && column <= colCapacity())
+        return;
+    relocate(row > _roomRows ? row : _roomRows,
+             column > colCapacity() ? column : colCapacity(), true);
+}
+
+inline int Grid<bool, RowMajorLayout>::rowCapacity() const {
+    return _roomRows;
+}
+
+inline int Grid<bool, RowMajorLayout>::colCapacity() const {
+    return _wordsPerRow * 64;
+}
+
+inline void Grid<bool, RowMajorLayout>::shrinkToFit() {
+    _reserveRows = 0;
+    _reserveColumns = 0;
+    if (_row != _roomRows || _wordsPerRow != usedWords())
+        relocate(_row, _column, true);
+}
+
+inline void Grid<bool, RowMajorLayout>::transpose() {
+    Grid result;                                /// keep the reserved room, turned
+    result.relocate(_reserveColumns > _column ? _reserveColumns : _column, _roomRows, false);
+    result._reserveRows = _reserveColumns;
+    result._reserveColumns = _reserveRows;
+    result.resize(_column, _row);
+    for (int r = 0; r < _row; r++)
+        for (int c = 0; c < _column; c++)
+            if ((*this)[r][c])
+                result[c][r] = true;
+    *this = std::move(result);
+}
+
+inline bool Grid<bool, RowMajorLayout>::at(int row, int col) const {
+    return get(row, col);
+}
+
+inline void Grid<bool, RowMajorLayout>::set(int row, int col, bool value) {
+    if (!inBounds(row, col))
+        throw "Exception :-(";
+    (*this)[row][col] = value;
+}
+
+inline int Grid<bool, RowMajorLayout>::size() const {
+    return _row * _column;
+}
+
+inline uint64_t* Grid<bool, RowMajorLayout>::words() {
+    markDirty(0, 0, _row, _column);
+    return _words;
+}
+
+inline const uint64_t* Grid<bool, RowMajorLayout>::words() const {
+    return _words;
+}
+
+inline int Grid<bool, RowMajorLayout>::wordsPerRow() const {
+    return _wordsPerRow;
+}
+
+template <typename Fn>
+void Grid<bool, RowMajorLayout>::forEachTile(Fn fn) const {
+    for (int r0 = 0; r0 < _row; r0 += TILE)
+        for (int c0 = 0; c0 < _column; c0 += TILE)
+            fn(r0, c0, _row - r0 < TILE ? _row - r0 : TILE,
+                       _column - c0 < TILE ? _column - c0 : TILE);
+}
+
+inline GridView<bool, RowMajorLayout> Grid<bool, RowMajorLayout>::view(int row, int col, int rows, int cols) {
+    if (row < 0 || col < 0 || rows < 0 || cols < 0
+        || row + rows > _row || col + cols > _column)
+        throw "Exception :-(";
+    markDirty(row, col, rows, cols);
+    return GridView<bool, RowMajorLayout>(_words, _wordsPerRow, row, col, rows, cols);
+}
+
+inline GridView<const bool, RowMajorLayout> Grid<bool, RowMajorLayout>::view(int row, int col, int rows, int cols) const {
+    if (row < 0 || col < 0 || rows < 0 || cols < 0
+        || row + rows > _row || col + cols > _column)
+        throw "Exception :-(";
+    return GridView<const bool, RowMajorLayout>(_words, _wordsPerRow, row, col, rows, cols);
+}
+
+inline int Grid<bool, RowMajorLayout>::tilesAcross() const {
+    return (_column + TILE - 1) / TILE;
+}
+
+inline int Grid<bool, RowMajorLayout>::dirtyWords() const {
+    int tiles = (_row + TILE - 1) / TILE * tilesAcross();
+    return (tiles + 63) / 64;
+}
+
+inline void Grid<bool, RowMajorLayout>::shapeDirty() {
+    delete[] _dirty;
+    _dirty = dirtyWords() > 0 ? new unsigned long long[dirtyWords()]() : nullptr;
+}
+
+inline void Grid<bool, RowMajorLayout>::markDirty(int row, int col, int rows, int cols) {
+    if (!_tracking || rows <= 0 || cols <= 0)
+        return;
+    int across = tilesAcross();
+    for (int tr = row / TILE; tr <= (row + rows - 1) / TILE; tr++) {
+        for (int tc = col / TILE; tc <= (col + cols - 1) / TILE; tc++) {
+            int bit = tr * across + tc;
+            _dirty[bit / 64] |= 1ull << (bit % 64);
+        }
+    }
+}
+
+inline void Grid<bool, RowMajorLayout>::trackDirty(bool on) {
+    _tracking = on;
+    delete[] _dirty;
+    _dirty = nullptr;
+    if (on)
+        shapeDirty();
+}
+
+inline bool Grid<bool, RowMajorLayout>::isDirty(int row, int col) const {
+    if (!_tracking || !inBounds(row, col))
+        return false;
+    int bit = row / TILE * tilesAcross() + col / TILE;
+    return (_dirty[bit / 64] >> (bit % 64)) & 1;
+}
+
+template <typename Fn>
+void Grid<bool, RowMajorLayout>::forEachDirtyTile(Fn fn) const {
+    if (!_tracking)
+        return;
+    int across = tilesAcross();
+    int tiles = (_row + TILE - 1) / TILE * across;
+    for (int w = 0; w * 64 < tiles; w++) {
+        for (unsigned long long bits = _dirty[w]; bits != 0; bits &= bits - 1) {
+#if defined(__GNUC__)
+            int bit = w * 64 + __builtin_ctzll(bits);
+#else
+            int bit = w * 64;
+            while (((bits >> (bit - w * 64)) & 1) == 0)
+                bit++;
+#endif
+            int r0 = bit / across * TILE;
+            int c0 = bit % across * TILE;
+            fn(r0, c0, _row - r0 < TILE ? _row - r0 : TILE,
+                       _column - c0 < TILE ? _column - c0 : TILE);
+        }
+    }
+}
+
+inline void Grid<bool, RowMajorLayout>::clearDirty() {
+    if (!_tracking)
+        return;
+    for (int i = 0; i < dirtyWords(); i++)
+        _dirty[i] = 0;
+}
+
+inline Grid<bool, RowMajorLayout>& Grid<bool, RowMajorLayout>::operator=(const Grid& grid) {
+    if (this != &grid) {
+        Grid copy(grid);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+inline Grid<bool, RowMajorLayout>& Grid<bool, RowMajorLayout>::operator=(Grid&& grid) {
+    if (this != &grid) {
+        delete[] _words;
+        _row = grid._row;
+        _column = grid._column;
+        _wordsPerRow = grid._wordsPerRow;
+        _words = grid._words;
+        _roomRows = grid._roomRows;
+        _reserveRows = grid._reserveRows;
+        _reserveColumns = grid._reserveColumns;
+        grid._words = nullptr;
+        grid._row = 0;
+        grid._column = 0;
+        grid._wordsPerRow = 0;
+        grid._roomRows = 0;
+        grid._reserveRows = 0;
+        grid._reserveColumns = 0;
+        if (_tracking) {                    /// tracking belongs to this Grid, not the value
+            shapeDirty();
+            markDirty(0, 0, _row, _column);
+        }
+    }
+    return *this;
+}
+
+inline Grid<bool, RowMajorLayout>::Row Grid<bool, RowMajorLayout>::operator[](int row) {
+    if (row < 0 || !(row < _row))
+        throw "Exception :-(";
+    if (!_tracking)
+        return Row(_words + row * _wordsPerRow);
+    return Row(_words + row * _wordsPerRow, _dirty, row / TILE * tilesAcross());
+}
+
+inline Grid<bool, RowMajorLayout>::ConstRow Grid<bool, RowMajorLayout>::operator[](int row) const {
+    if (row < 0 || !(row < _row))
+        throw "Exception :-(";
+    return ConstRow(_words + row * _wordsPerRow);
+}
+
+template <typename Fn>
+void Grid<bool, RowMajorLayout>::combine(const Grid& grid, Fn fn) {
+    if (_row != grid._row || _column != grid._column)
+        throw "Exception :-(";
+    int used = usedWords();
+    for (int r = 0; r < _row; r++) {
+        uint64_t* mine = _words + r * _wordsPerRow;
+        const uint64_t* theirs = grid._words + r * grid._wordsPerRow;
+        for (int w = 0; w < used; w++)
+            mine[w] = fn(mine[w], theirs[w]);
+    }
+    markDirty(0, 0, _row, _column);
+}
+
+template <typename Fn>
+bool Grid<bool, RowMajorLayout>::all(const Grid& grid, Fn fn) const {
+    if (_row != grid._row || _column != grid._column)
+        return false;
+    int used = usedWords();
+    for (int r = 0; r < _row; r++) {
+        const uint64_t* mine = _words + r * _wordsPerRow;
+        const uint64_t* theirs = grid._words + r * grid._wordsPerRow;
+        for (int w = 0; w < used; w++) {
+            uint64_t mask = w == used - 1 ? lastMask() : ~uint64_t(0);
+            if (!fn(mine[w], theirs[w], mask))
+                return false;
+        }
+    }
+    return true;
+}
+
+inline Grid<bool, RowMajorLayout>& Grid<bool, RowMajorLayout>::operator&=(const Grid& grid) {
+    combine(grid, [](uint64_t a, uint64_t b) { return a & b; });
+    return *this;
+}
+
+inline Grid<bool, RowMajorLayout>& Grid<bool, RowMajorLayout>::operator|=(const Grid& grid) {
+    combine(grid, [](uint64_t a, uint64_t b) { return a | b; });
+    return *this;
+}
+
+inline Grid<bool, RowMajorLayout>& Grid<bool, RowMajorLayout>::operator^=(const Grid& grid) {
+    combine(grid, [](uint64_t a, uint64_t b) { return a ^ b; });
+    return *this;
+}
+
+inline Grid<bool, RowMajorLayout> Grid<bool, RowMajorLayout>::operator&(const Grid& grid) const {
+    Grid result(*this);
+    result &= grid;
+    return result;
+}
+
+inline Grid<bool, RowMajorLayout> Grid<bool, RowMajorLayout>::operator|(const Grid& grid) const {
+    Grid result(*this);
+    result |= grid;
+    return result;
+}
+
+inline Grid<bool, RowMajorLayout> Grid<bool, RowMajorLayout>::operator^(const Grid& grid) const {
+    Grid result(*this);
+    result ^= grid;
+    return result;
+}
+
+inline Grid<bool, RowMajorLayout> Grid<bool, RowMajorLayout>::operator~() const {
+    Grid result(*this);
+    result.flip();
+    return result;
+}
+
+inline bool Grid<bool, RowMajorLayout>::operator==(const Grid& grid) const {
+    return equals(grid);
+}
+
+inline bool Grid<bool, RowMajorLayout>::operator!=(const Grid& grid) const {
+    return !equals(grid);
+}
+
+inline bool Grid<bool, RowMajorLayout>::operator<(const Grid& grid) const {
+    return all(grid, [](uint64_t a, uint64_t b, uint64_t mask) { return (a & mask) == 0 && (b & mask) == mask; });
+}
+
+inline bool Grid<bool, RowMajorLayout>::operator<=(const Grid& grid) const {
+    return all(grid, [](uint64_t a, uint64_t b, uint64_t mask) { return (a & ~b & mask) == 0; });
+}
+
+inline bool Grid<bool, RowMajorLayout>::operator>(const Grid& grid) const {
+    return grid < *this;
+}
+
+inline bool Grid<bool, RowMajorLayout>::operator>=(const Grid& grid) const {
+    return grid <= *this;
+}
+
+inline ostream& operator<<(ostream& out, const Grid<bool, RowMajorLayout>& grid) {
+    out << "{ ";
+    for (int i = 0; i < grid._row; i++) {
+        out << "{ ";
+        for (int j = 0; j < grid._column; j++)
+            if (j == grid._column - 1)
+                out << grid[i][j];
+            else
+                out << grid[i][j] << ",";
+        out << " }";
+        if (i != grid._row - 1)
+            out << "," << endl << "  ";
+    }
+    out << " } ";
+    return out;
+}
+
+
+#endif // _gridbool_h
@@ -0,0 +1,277 @@
+#ifndef _gridlayout_h
+#define _gridlayout_h
+
+#include <climits>
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+/**
+*  Storage layouts for Grid.  A layout maps a <code>row</code>/<code>col</code>
+*  position to an offset in the Grid's single block of elements:
+*
+*    shape(rows, cols)   prepares the mapping for a rows x cols Grid,
+*                        with no room to spare
+*    reserve(rows, cols) spaces the mapping out for up to rows x cols
+*                        cells, kept in reservedRows and reservedCols;
+*                        within that room the shape is just the rows and
+*                        cols fields, and every cell keeps its offset
+*                        when they change
+*    capacity()          elements the block must hold, padding included
+*    index(row, col)     offset of a cell in the block
+*    runs(fn)            calls fn(row, col, index, length) for every run of
+*                        cells that are adjacent both in the row and in
+*                        memory, in memory order
+*    tile                side of the square blocks forEachTile walks
+*    contiguousRows      whether a whole row is one run, so that
+*                        Grid::operator[] can hand out a plain pointer
+*/
+
+/**
+*  The classic layout: rows one after another, each row contiguous.
+*/
+struct RowMajorLayout {
+    static const bool contiguousRows = true;
+    static const int tile = 32;
+
+    int rows = 0;
+    int cols = 0;
+    int reservedRows = 0;
+    int reservedCols = 0;
+    int stride = 0;       // Elements from one row to the next
+
+    void shape(int rows, int cols) {
+        reserve(rows, cols);
+        this->rows = rows;
+        this->cols = cols;
+    }
+
+    void reserve(int rows, int cols) {
+        reservedRows = rows;
+        reservedCols = cols;
+        stride = cols;
+    }
+
+    int capacity() const {
+        return reservedRows * stride;
+    }
+
+    int index(int row, int col) const {
+        return row * stride + col;
+    }
+
+    template <typename Fn>
+    void runs(Fn fn) const {
+        for (int r = 0; r < rows; r++)
+            fn(r, 0, r * stride, cols);
+    }
+};
+
+/**
+*  Cache-blocked layout: the Grid is cut into <code>size</code> x
+*  <code>size</code> tiles, each stored contiguously row by row, and the
+*  tiles follow each other row by row.  A tile of 32 x 32 floats is 4KB,
+*  so column walks and 2D neighbourhoods stay within a few pages instead
+*  of touching one cache line per row.  Edge tiles are padded.
+*/
+template <int size>
+struct TiledLayout {
+    static_assert(size > 0 && (size & (size - 1)) == 0,
+                  "TiledLayout size must be a power of two");
+
+    static const bool contiguousRows = false;
+    static const int tile = size;
+
+    int rows = 0;
+    int cols = 0;
+    int reservedRows = 0;
+    int reservedCols = 0;
+    int across = 0;       // Tiles in one row of tiles
+
+    void shape(int rows, int cols) {
+        reserve(rows, cols);
+        this->rows = rows;
+        this->cols = cols;
+    }
+
+    void reserve(int rows, int cols) {
+        reservedRows = rows;
+        reservedCols = cols;
+        across = (cols + size - 1) / size;
+    }
+
+    int capacity() const {
+        return (reservedRows + size - 1) / size * across * size * size;
+    }
+
+    int index(int row, int col) const {
+        unsigned r = row;
+        unsigned c = col;
+        return (int)(((r / size) * across + c / size) * (size * size)
+                     + (r % size) * size + c % size);
+    }
+
+    template <typename Fn>
+    void runs(Fn fn) const {
+        for (int r0 = 0; r0 < rows; r0 += size) {
+            int height = rows - r0 < size ? rows - r0 : size;
+            for (int c0 = 0; c0 < cols; c0 += size) {
+                int width = cols - c0 < size ? cols - c0 : size;
+                int start = index(r0, c0);
+                for (int r = 0; r < height; r++)
+                    fn(r0 + r, c0, start + r * size, width);
+            }
+        }
+    }
+};
+
+/**
+*  Z-order (Morton) layout: the bits of the row and column are interleaved
+*  to form the offset, so every aligned 2^k x 2^k square is one contiguous
+*  block and nearby cells in any direction are nearby in memory.  Region
+*  queries at arbitrary positions touch far fewer cache lines than with
+*  rows, for tall and wide neighbourhoods alike.
+*
+*  Each side is padded up to a power of two.  When the sides differ, the
+*  low bits are interleaved up to the shorter side and the remaining high
+*  bits of the longer side go on top, so a 100 x 1000 Grid does not pay
+*  for a 1024 x 1024 square.  Interleaving uses the BMI2 pdep/pext
+*  instructions when the compiler targets them, and bit tricks otherwise.
+*  The padded block may hold at most 2^30 cells.
+*/
+struct MortonLayout {
+    static const bool contiguousRows = false;
+    static const int tile = 16;
+
+    int rows = 0;
+    int cols = 0;
+    int reservedRows = 0;
+    int reservedCols = 0;
+    int rowBits = 0;      // Bits needed for a reserved row number
+    int colBits = 0;      // Bits needed for a reserved column number
+    int shared = 0;       // Low bits of each that are interleaved
+
+    void shape(int rows, int cols) {
+        reserve(rows, cols);
+        this->rows = rows;
+        this->cols = cols;
+    }
+
+    /**
+    *  @throw "Exception" if the padded block has more cells than an int
+    *         can count, which index and runs rely on
+    */
+    void reserve(int rows, int cols) {
+        int needRows = bits(rows);
+        int needCols = bits(cols);
+        if (rows > 0 && cols > 0 && (1LL << (needRows + needCols)) > INT_MAX)
+            throw "Exception :-(";
+        reservedRows = rows;
+        reservedCols = cols;
+        rowBits = needRows;
+        colBits = needCols;
+        shared = rowBits < colBits ? rowBits : colBits;
+    }
+
+    int capacity() const {
+        return reservedRows > 0 && reservedCols > 0 ? (int)(1LL << (rowBits + colBits)) : 0;
+    }
+
+    int index(int row, int col) const {
+        unsigned mask = (1u << shared) - 1;
+        unsigned low = interleave(row & mask, col & mask);
+        unsigned high = (unsigned)(row >> shared) | (unsigned)(col >> shared);
+        return (int)((high << (2 * shared)) | low);
+    }
+
+    /**
+    *  Walks the block in memory order.  Only the two cells that share all
+    *  but the lowest column bit are adjacent in both row and memory; a
+    *  single column has no column bits, so there every cell is its own run.
+    */
+    template <typename Fn>
+    void runs(Fn fn) const {
+        int total = capacity();
+        int step = colBits > 0 ? 2 : 1;
+        for (int index = 0; index < total; index += step) {
+            int row;
+            int col;
+            cell(index, row, col);
+            if (row >= rows || col >= cols)
+                continue;
+            fn(row, col, index, col + 1 < cols ? 2 : 1);
+        }
+    }
+
+    /**
+    *  The inverse of <code>index</code>.
+    */
+    void cell(int index, int& row, int& col) const {
+        unsigned low = (unsigned)index & ((1u << (2 * shared)) - 1);
+        unsigned high = (unsigned)index >> (2 * shared);
+        row = (int)oddBits(low);
+        col = (int)evenBits(low);
+        if (rowBits > colBits)
+            row |= (int)(high << shared);
+        else
+            col |= (int)(high << shared);
+    }
+
+    static int bits(int extent) {
+        int count = 0;
+        while ((1LL << count) < extent)
+            count++;
+        return count;
+    }
+
+    /**
+    *  Spreads the row bits over the odd positions and the column bits over
+    *  the even positions.
+    */
+    static unsigned interleave(unsigned row, unsigned col) {
+#if defined(__BMI2__)
+        return _pdep_u32(row, 0xAAAAAAAAu) | _pdep_u32(col, 0x55555555u);
+#else
+        return (spread(row) << 1) | spread(col);
+#endif
+    }
+
+    static unsigned oddBits(unsigned code) {
+#if defined(__BMI2__)
+        return _pext_u32(code, 0xAAAAAAAAu);
+#else
+        return compact(code >> 1);
+#endif
+    }
+
+    static unsigned evenBits(unsigned code) {
+#if defined(__BMI2__)
+        return _pext_u32(code, 0x55555555u);
+#else
+        return compact(code);
+#endif
+    }
+
+    static unsigned spread(unsigned x) {
+        x &= 0x0000FFFFu;
+        x = (x | (x << 8)) & 0x00FF00FFu;
+        x = (x | (x << 4)) & 0x0F0F0F0Fu;
+        x = (x | (x << 2)) & 0x33333333u;
+        x = (x | (x << 1)) & 0x55555555u;
+        return x;
+    }
+
+    static unsigned compact(unsigned x) {
+        x &= 0x55555555u;
+        x = (x | (x >> 1)) & 0x33333333u;
+        x = (x | (x >> 2)) & 0x0F0F0F0Fu;
+        x = (x | (x >> 4)) & 0x00FF00FFu;
+        x = (x | (x >> 8)) & 0x0000FFFFu;
+        return x;
+    }
+};
+
+
+#endif // _gridlayout_h
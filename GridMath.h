@@ -0,0 +1,320 @@
+#ifndef _gridmath_h
+#define _gridmath_h
+
+#include <type_traits>
+#include "Grid.h"
+#include "Vector.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+/**
+*  Linear algebra on arithmetic row-major Grids used as matrices.
+*
+*  <code>multiply</code> is a blocked GEMM in the GotoBLAS style: the right
+*  operand is packed into panels that stay in L3, the left operand into
+*  panels that stay in L2, and a register-blocked micro-kernel computes one
+*  small tile of the result at a time from L1.  For float and double the
+*  micro-kernel uses AVX2/FMA when the compiler targets it
+*  (<code>-mavx2 -mfma</code> or <code>-march=native</code>); every other
+*  case runs the same blocking with a scalar kernel.
+*
+*  Every function throws "Exception :-(" if the shapes do not match.
+*/
+
+/**
+*  The register-blocked micro-kernel for element type <code>type</code>.
+*  It adds the MR x NR product of a packed MR-row panel of A and a packed
+*  NR-column panel of B, <code>kc</code> deep, into C.
+*/
+template <typename type>
+struct GemmKernel {
+    static const int MR = 4;
+    static const int NR = 8;
+
+    static void run(int kc, const type* a, const type* b, type* c, int ldc) {
+        type acc[MR][NR] = {};
+        for (int p = 0; p < kc; p++) {
+            for (int i = 0; i < MR; i++) {
+                type ai = a[p * MR + i];
+                for (int j = 0; j < NR; j++)
+                    acc[i][j] += ai * b[p * NR + j];
+            }
+        }
+        for (int i = 0; i < MR; i++)
+            for (int j = 0; j < NR; j++)
+                c[i * ldc + j] += acc[i][j];
+    }
+};
+
+#if defined(__AVX2__) && defined(__FMA__)
+
+template <>
+struct GemmKernel<double> {
+    static const int MR = 4;
+    static const int NR = 8;
+
+    static void run(int kc, const double* a, const double* b, double* c, int ldc) {
+        __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+        __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+        __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+        __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+        for (int p = 0; p < kc; p++) {
+            __m256d b0 = _mm256_loadu_pd(b);
+            __m256d b1 = _mm256_loadu_pd(b + 4);
+            __m256d a0 = _mm256_broadcast_sd(a);
+            __m256d a1 = _mm256_broadcast_sd(a + 1);
+            c00 = _mm256_fmadd_pd(a0, b0, c00);
+            c01 = _mm256_fmadd_pd(a0, b1, c01);
+            c10 = _mm256_fmadd_pd(a1, b0, c10);
+            c11 = _mm256_fmadd_pd(a1, b1, c11);
+            __m256d a2 = _mm256_broadcast_sd(a + 2);
+            __m256d a3 = _mm256_broadcast_sd(a + 3);
+            c20 = _mm256_fmadd_pd(a2, b0, c20);
+            c21 = _mm256_fmadd_pd(a2, b1, c21);
+            c30 = _mm256_fmadd_pd(a3, b0, c30);
+            c31 = _mm256_fmadd_pd(a3, b1, c31);
+            a += MR;
+            b += NR;
+        }
+        add(c, c00, c01);
+        add(c + ldc, c10, c11);
+        add(c + 2 * ldc, c20, c21);
+        add(c + 3 * ldc, c30, c31);
+    }
+
+    static void add(double* c, __m256d lo, __m256d hi) {
+        _mm256_storeu_pd(c, _mm256_add_pd(_mm256_loadu_pd(c), lo));
+        _mm256_storeu_pd(c + 4, _mm256_add_pd(_mm256_loadu_pd(c + 4), hi));
+    }
+};
+
+template <>
+struct GemmKernel<float> {
+    static const int MR = 4;
+    static const int NR = 16;
+
+    static void run(int kc, const float* a, const float* b, float* c, int ldc) {
+        __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+        __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+        __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+        __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+        for (int p = 0; p < kc; p++) {
+            __m256 b0 = _mm256_loadu_ps(b);
+            __m256 b1 = _mm256_loadu_ps(b + 8);
+            __m256 a0 = _mm256_broadcast_ss(a);
+            __m256 a1 = _mm256_broadcast_ss(a + 1);
+            c00 = _mm256_fmadd_ps(a0, b0, c00);
+            c01 = _mm256_fmadd_ps(a0, b1, c01);
+            c10 = _mm256_fmadd_ps(a1, b0, c10);
+            c11 = _mm256_fmadd_ps(a1, b1, c11);
+            __m256 a2 = _mm256_broadcast_ss(a + 2);
+            __m256 a3 = _mm256_broadcast_ss(a + 3);
+            c20 = _mm256_fmadd_ps(a2, b0, c20);
+            c21 = _mm256_fmadd_ps(a2, b1, c21);
+            c30 = _mm256_fmadd_ps(a3, b0, c30);
+            c31 = _mm256_fmadd_ps(a3, b1, c31);
+            a += MR;
+            b += NR;
+        }
+        add(c, c00, c01);
+        add(c + ldc, c10, c11);
+        add(c + 2 * ldc, c20, c21);
+        add(c + 3 * ldc, c30, c31);
+    }
+
+    static void add(float* c, __m256 lo, __m256 hi) {
+        _mm256_storeu_ps(c, _mm256_add_ps(_mm256_loadu_ps(c), lo));
+        _mm256_storeu_ps(c + 8, _mm256_add_ps(_mm256_loadu_ps(c + 8), hi));
+    }
+};
+
+#endif
+
+/**
+*  Packs rows <code>[row, row + mc)</code>, columns <code>[col, col + kc)</code>
+*  of <code>a</code> into MR-row panels, column by column, zero padding the
+*  last panel.
+*/
+template <typename type>
+void gemmPackA(const Grid<type>& a, int row, int col, int mc, int kc, type* packed) {
+    const int MR = GemmKernel<type>::MR;
+    const type* base = a.data();
+    int lda = a.stride();
+    for (int i0 = 0; i0 < mc; i0 += MR) {
+        for (int p = 0; p < kc; p++) {
+            for (int i = 0; i < MR; i++)
+                *packed++ = i0 + i < mc ? base[(row + i0 + i) * lda + col + p] : type();
+        }
+    }
+}
+
+/**
+*  Packs rows <code>[row, row + kc)</code>, columns <code>[col, col + nc)</code>
+*  of <code>b</code> into NR-column panels, row by row, zero padding the
+*  last panel.
+*/
+template <typename type>
+void gemmPackB(const Grid<type>& b, int row, int col, int kc, int nc, type* packed) {
+    const int NR = GemmKernel<type>::NR;
+    const type* base = b.data();
+    int ldb = b.stride();
+    for (int j0 = 0; j0 < nc; j0 += NR) {
+        for (int p = 0; p < kc; p++) {
+            const type* source = base + (row + p) * ldb + col + j0;
+            for (int j = 0; j < NR; j++)
+                *packed++ = j0 + j < nc ? source[j] : type();
+        }
+    }
+}
+
+/**
+*  Returns the matrix product <code>a * b</code>.
+*/
+template <typename type>
+Grid<type> multiply(const Grid<type>& a, const Grid<type>& b) {
+    static_assert(is_arithmetic<type>::value, "multiply needs an arithmetic type");
+    if (a.numCols() != b.numRows())
+        throw "Exception :-(";
+
+    const int MR = GemmKernel<type>::MR;
+    const int NR = GemmKernel<type>::NR;
+    const int KC = 256;                     // Depth of a packed panel
+    const int MC = 96;                      // Rows of A packed at once, L2
+    const int NC = 2048;                    // Columns of B packed at once, L3
+
+    int m = a.numRows();
+    int n = b.numCols();
+    int k = a.numCols();
+    Grid<type> c(m, n);
+    if (m == 0 || n == 0 || k == 0)
+        return c;
+
+    type* packedA = new type[MC * KC];
+    type* packedB = new type[KC * ((NC + NR - 1) / NR * NR)];
+    type edge[MR * NR];
+    type* out = c.data();
+    int ldc = c.stride();
+
+    for (int jc = 0; jc < n; jc += NC) {
+        int nc = n - jc < NC ? n - jc : NC;
+        for (int pc = 0; pc < k; pc += KC) {
+            int kc = k - pc < KC ? k - pc : KC;
+            gemmPackB(b, pc, jc, kc, nc, packedB);
+
+            for (int ic = 0; ic < m; ic += MC) {
+                int mc = m - ic < MC ? m - ic : MC;
+                gemmPackA(a, ic, pc, mc, kc, packedA);
+
+                for (int jr = 0; jr < nc; jr += NR) {
+                    int nr = nc - jr < NR ? nc - jr : NR;
+                    const type* panelB = packedB + jr * kc;
+                    for (int ir = 0; ir < mc; ir += MR) {
+                        int mr = mc - ir < MR ? mc - ir : MR;
+                        const type* panelA = packedA + ir * kc;
+                        type* tile = out + (ic + ir) * ldc + jc + jr;
+                        if (mr == MR && nr == NR) {
+                            GemmKernel<type>::run(kc, panelA, panelB, tile, ldc);
+                        } else {                    /// partial tile at an edge
+                            for (int i = 0; i < MR * NR; i++)
+                                edge[i] = type();
+                            GemmKernel<type>::run(kc, panelA, panelB, edge, NR);
+                            for (int i = 0; i < mr; i++)
+                                for (int j = 0; j < nr; j++)
+                                    tile[i * ldc + j] += edge[i * NR + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    delete[] packedA;
+    delete[] packedB;
+    return c;
+}
+
+/**
+*  Returns the matrix-vector product <code>a * x</code>.
+*/
+template <typename type>
+Vector<type> multiply(const Grid<type>& a, const Vector<type>& x) {
+    static_assert(is_arithmetic<type>::value, "multiply needs an arithmetic type");
+    if (a.numCols() != x.size())
+        throw "Exception :-(";
+
+    Vector<type> y(a.numRows());
+    const type* vector = a.numCols() > 0 ? &x[0] : nullptr;
+    for (int i = 0; i < a.numRows(); i++) {
+        const type* row = a[i];
+        type sum0 = type(), sum1 = type(), sum2 = type(), sum3 = type();
+        int j = 0;
+        for (; j + 4 <= a.numCols(); j += 4) {  /// independent sums vectorize
+            sum0 += row[j] * vector[j];
+            sum1 += row[j + 1] * vector[j + 1];
+            sum2 += row[j + 2] * vector[j + 2];
+            sum3 += row[j + 3] * vector[j + 3];
+        }
+        for (; j < a.numCols(); j++)
+            sum0 += row[j] * vector[j];
+        y[i] = (sum0 + sum1) + (sum2 + sum3);
+    }
+    return y;
+}
+
+/**
+*  Returns the transpose of <code>a</code>, copied with cache-oblivious
+*  blocking and in-register 4 x 4 / 8 x 8 transposes (see GridTranspose.h).
+*/
+template <typename type>
+Grid<type> transpose(const Grid<type>& a) {
+    Grid<type> t(a.numCols(), a.numRows());
+    if (!a.empty())
+        transposeCopy<type>(a.data(), a.stride(), t.data(), t.stride(), a.numRows(), a.numCols());
+    return t;
+}
+
+/**
+*  Adds <code>alpha * x</code> to <code>y</code> in place (axpy).
+*/
+template <typename type>
+void axpy(type alpha, const Grid<type>& x, Grid<type>& y) {
+    static_assert(is_arithmetic<type>::value, "axpy needs an arithmetic type");
+    if (x.numRows() != y.numRows() || x.numCols() != y.numCols())
+        throw "Exception :-(";
+    for (int i = 0; i < y.numRows(); i++) {
+        const type* source = x[i];
+        type* target = y[i];
+        for (int j = 0; j < y.numCols(); j++)
+            target[j] += alpha * source[j];
+    }
+}
+
+/**
+*  Returns the elementwise sum <code>a + b</code>.
+*/
+template <typename type>
+Grid<type> add(const Grid<type>& a, const Grid<type>& b) {
+    Grid<type> sum(a);
+    axpy(type(1), b, sum);
+    return sum;
+}
+
+/**
+*  Multiplies every element of <code>a</code> by <code>alpha</code> in place.
+*/
+template <typename type>
+void scale(Grid<type>& a, type alpha) {
+    static_assert(is_arithmetic<type>::value, "scale needs an arithmetic type");
+    for (int i = 0; i < a.numRows(); i++) {
+        type* row = a[i];
+        for (int j = 0; j < a.numCols(); j++)
+            row[j] *= alpha;
+    }
+}
+
+
+#endif // _gridmath_h
@@ -0,0 +1,256 @@
+#ifndef _gridparallel_h
+#define _gridparallel_h
+
+#include <type_traits>
+#include "Grid.h"
+#include "Vector.h"
+#include "TaskScheduler.h"
+
+using namespace std;
+
+/**
+*  Whole-Grid passes spread over a TaskScheduler: the rows are cut into
+*  bands and every band is one task, so a pass over a big Grid keeps every
+*  core busy.  Each function takes the scheduler to use, the shared
+*  <code>TaskScheduler::instance()</code> by default, and the rows per
+*  band, by default enough bands for four per worker.
+*
+*  Reductions fold each contiguous row into eight independent lanes, which
+*  the compiler can keep in one vector register, so <code>op</code> must
+*  be associative and commutative and <code>init</code> must be its
+*  identity (0 for a sum).  The functions must not throw.
+*
+*  Passes that write take one view of the whole Grid on the calling
+*  thread, which marks every tile dirty once, and give each band a
+*  sub-view of it, so the tasks never touch the Grid's dirty bits.  On a
+*  Grid&lt;bool&gt; those views fill and map a word at a time.
+*/
+
+/**
+*  Returns the rows per band: <code>band</code> if it is positive,
+*  otherwise enough for four bands per worker.
+*/
+inline int bandRows(int rows, TaskScheduler& scheduler, int band) {
+    if (band > 0)
+        return band;
+    band = rows / (4 * scheduler.threads());
+    return band > 0 ? band : 1;
+}
+
+/**
+*  Calls <code>fn(first, last)</code> for bands of <code>band</code> rows
+*  covering <code>[0, rows)</code>, in parallel.
+*/
+template <typename Fn>
+void forEachBand(int rows, Fn fn, TaskScheduler& scheduler, int band) {
+    if (rows <= 0)
+        return;
+    band = bandRows(rows, scheduler, band);
+    int bands = (rows + band - 1) / band;
+    scheduler.parallel_for(0, bands, [&fn, band, rows](int b) {
+        int last = (b + 1) * band < rows ? (b + 1) * band : rows;
+        fn(b * band, last);
+    });
+}
+
+/**
+*  Returns <code>op</code> folded over <code>length</code> contiguous
+*  values, eight lanes at a time.
+*/
+template <typename type, typename Op>
+type reduceRun(const type* run, int length, const type& init, Op& op) {
+    const int LANES = 8;
+    type lanes[LANES];
+    for (int k = 0; k < LANES; k++)
+        lanes[k] = init;
+    int c = 0;
+    for (; c + LANES <= length; c += LANES)
+        for (int k = 0; k < LANES; k++)
+            lanes[k] = op(lanes[k], run[c + k]);
+    type result = init;
+    for (int k = 0; k < LANES; k++)
+        result = op(result, lanes[k]);
+    for (; c < length; c++)
+        result = op(result, run[c]);
+    return result;
+}
+
+/**
+*  Returns <code>op</code> folded over row <code>row</code>.
+*/
+template <typename type, typename Layout, typename Op>
+type reduceRow(const Grid<type, Layout>& grid, int row, const type& init, Op& op) {
+    if constexpr (is_pointer<typename Grid<type, Layout>::ConstRowType>::value) {
+        return reduceRun(grid[row], grid.numCols(), init, op);
+    } else {
+        type result = init;
+        for (int c = 0; c < grid.numCols(); c++)
+            result = op(result, grid[row][c]);
+        return result;
+    }
+}
+
+/**
+*  Replaces every element <code>x</code> of the Grid by <code>fn(x)</code>,
+*  in parallel.
+*/
+template <typename type, typename Layout, typename Fn>
+void parallel_map(Grid<type, Layout>& grid, Fn fn,
+                  TaskScheduler& scheduler = TaskScheduler::instance(), int band = 0) {
+    int cols = grid.numCols();
+    GridView<type, Layout> whole = grid.view(0, 0, grid.numRows(), cols);
+    forEachBand(grid.numRows(), [&whole, &fn, cols](int first, int last) {
+        whole.view(first, 0, last - first, cols).map(fn);
+    }, scheduler, band);
+}
+
+/**
+*  Stores <code>value</code> in every cell of the Grid, in parallel.
+*/
+template <typename type, typename Layout>
+void parallel_fill(Grid<type, Layout>& grid, const type& value,
+                   TaskScheduler& scheduler = TaskScheduler::instance(), int band = 0) {
+    int cols = grid.numCols();
+    GridView<type, Layout> whole = grid.view(0, 0, grid.numRows(), cols);
+    forEachBand(grid.numRows(), [&whole, &value, cols](int first, int last) {
+        whole.view(first, 0, last - first, cols).fill(value);
+    }, scheduler, band);
+}
+
+/**
+*  Sets every cell of the Grid to its element type's default value, in
+*  parallel.
+*/
+template <typename type, typename Layout>
+void parallel_clear(Grid<type, Layout>& grid,
+                    TaskScheduler& scheduler = TaskScheduler::instance(), int band = 0) {
+    parallel_fill(grid, type(), scheduler, band);
+}
+
+/**
+*  Returns <code>op</code> folded over every cell of the Grid, starting
+*  from <code>init</code>, computed in parallel.
+*/
+template <typename type, typename Layout, typename Op>
+type parallel_reduce(const Grid<type, Layout>& grid, const type& init, Op op,
+                     TaskScheduler& scheduler = TaskScheduler::instance(), int band = 0) {
+    int rows = grid.numRows();
+    if (rows == 0)
+        return init;
+    band = bandRows(rows, scheduler, band);
+    Vector<type> partials((rows + band - 1) / band, init);
+    forEachBand(rows, [&grid, &partials, &init, &op, band](int first, int last) {
+        type result = init;
+        for (int r = first; r < last; r++)
+            result = op(result, reduceRow(grid, r, init, op));
+        partials[first / band] = result;
+    }, scheduler, band);
+    return reduceRun(&partials[0], partials.size(), init, op);
+}
+
+/**
+*  Returns the sum of every cell of the Grid.
+*/
+template <typename type, typename Layout>
+type parallel_sum(const Grid<type, Layout>& grid,
+                  TaskScheduler& scheduler = TaskScheduler::instance(), int band = 0) {
+    return parallel_reduce(grid, type(), [](const type& a, const type& b) { return a + b; }, scheduler, band);
+}
+
+/**
+*  Returns the smallest cell of the Grid.
+*  @throw "Exception" if the Grid is empty.
+*/
+template <typename type, typename Layout>
+type parallel_min(const Grid<type, Layout>& grid,
+                  TaskScheduler& scheduler = TaskScheduler::instance(), int band = 0) {
+    return parallel_reduce(grid, grid.front(), [](const type& a, const type& b) { return b < a ? b : a; },
+                           scheduler, band);
+}
+
+/**
+*  Returns the largest cell of the Grid.
+*  @throw "Exception" if the Grid is empty.
+*/
+template <typename type, typename Layout>
+type parallel_max(const Grid<type, Layout>& grid,
+                  TaskScheduler& scheduler = TaskScheduler::instance(), int band = 0) {
+    return parallel_reduce(grid, grid.front(), [](const type& a, const type& b) { return a < b ? b : a; },
+                           scheduler, band);
+}
+
+/**
+*  Returns <code>op</code> folded over each row, one entry per row.
+*/
+template <typename type, typename Layout, typename Op>
+Vector<type> reduceRows(const Grid<type, Layout>& grid, const type& init, Op op,
+                        TaskScheduler& scheduler = TaskScheduler::instance(), int band = 0) {
+    Vector<type> result(grid.numRows(), init);
+    forEachBand(grid.numRows(), [&grid, &result, &init, &op](int first, int last) {
+        for (int r = first; r < last; r++)
+            result[r] = reduceRow(grid, r, init, op);
+    }, scheduler, band);
+    return result;
+}
+
+/**
+*  Returns <code>op</code> folded over each column, one entry per column.
+*  Every band folds its rows into a row of partial results elementwise,
+*  which vectorizes across the columns, and the bands are then combined.
+*/
+template <typename type, typename Layout, typename Op>
+Vector<type> reduceCols(const Grid<type, Layout>& grid, const type& init, Op op,
+                        TaskScheduler& scheduler = TaskScheduler::instance(), int band = 0) {
+    int rows = grid.numRows();
+    int cols = grid.numCols();
+    Vector<type> result(cols, init);
+    if (rows == 0 || cols == 0)
+        return result;
+
+    band = bandRows(rows, scheduler, band);
+    int bands = (rows + band - 1) / band;
+    Vector<type> partials(bands * cols);              /// one row of partial results per band
+    forEachBand(rows, [&grid, &partials, &init, &op, band, cols](int first, int last) {
+        type* target = &partials[first / band * cols];
+        for (int c = 0; c < cols; c++)
+            target[c] = init;
+        for (int r = first; r < last; r++) {
+            if constexpr (is_pointer<typename Grid<type, Layout>::ConstRowType>::value) {
+                const type* source = grid[r];
+                for (int c = 0; c < cols; c++)
+                    target[c] = op(target[c], source[c]);
+            } else {
+                for (int c = 0; c < cols; c++)
+                    target[c] = op(target[c], grid[r][c]);
+            }
+        }
+    }, scheduler, band);
+
+    for (int b = 0; b < bands; b++) {
+        const type* source = &partials[b * cols];
+        for (int c = 0; c < cols; c++)
+            result[c] = op(result[c], source[c]);
+    }
+    return result;
+}
+
+/**
+*  Returns the sum of each row.
+*/
+template <typename type, typename Layout>
+Vector<type> sumRows(const Grid<type, Layout>& grid,
+                     TaskScheduler& scheduler = TaskScheduler::instance(), int band = 0) {
+    return reduceRows(grid, type(), [](const type& a, const type& b) { return a + b; }, scheduler, band);
+}
+
+/**
+*  Returns the sum of each column.
+*/
+template <typename type, typename Layout>
+Vector<type> sumCols(const Grid<type, Layout>& grid,
+                     TaskScheduler& scheduler = TaskScheduler::instance(), int band = 0) {
+    return reduceCols(grid, type(), [](const type& a, const type& b) { return a + b; }, scheduler, band);
+}
+
+
+#endif // _gridparallel_h
@@ -0,0 +1,327 @@
+#ifndef _gridsearch_h
+#define _gridsearch_h
+
+#include <cstdint>
+#include <limits>
+#include "Grid.h"
+#include "Vector.h"
+
+using namespace std;
+
+/**
+*  Region and path searches over the 4-connected cells of a Grid, built to
+*  run on Grids of tens of millions of cells without allocating per cell:
+*  the frontier is one ring buffer of cell numbers
+*  (<code>row * cols + col</code>), and cells already reached are kept in
+*  a bit-packed Grid&lt;bool&gt;, 64 to a word.
+*/
+
+/**
+*  A cell position.
+*/
+struct GridPoint {
+    int row;
+    int col;
+
+    bool operator==(const GridPoint& point) const {
+        return row == point.row && col == point.col;
+    }
+
+    bool operator!=(const GridPoint& point) const {
+        return !(*this == point);
+    }
+};
+
+/**
+*  A FIFO of cell numbers in one contiguous power-of-two ring, doubled
+*  when it fills up.  A breadth-first frontier only ever holds about one
+*  ring of cells around the start, so it stays small and in cache.
+*/
+class GridFrontier {
+public:
+    GridFrontier(int capacity = 1024) : _items(1), _head(0), _size(0) {
+        int size = 1;
+        while (size < capacity)
+            size *= 2;
+        Vector<int> items(size);
+        _items.swap(items);
+        _mask = size - 1;
+    }
+
+    void push(int cell) {
+        if (_size == _mask + 1)
+            grow();
+        _items[(_head + _size) & _mask] = cell;
+        _size++;
+    }
+
+    int pop() {
+        int cell = _items[_head];
+        _head = (_head + 1) & _mask;
+        _size--;
+        return cell;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    int size() const {
+        return _size;
+    }
+
+private:
+    void grow() {
+        Vector<int> items(2 * (_mask + 1));
+        for (int i = 0; i < _size; i++)
+            items[i] = _items[(_head + i) & _mask];
+        _items.swap(items);
+        _head = 0;
+        _mask = 2 * _mask + 1;
+    }
+
+    // member variable (fields)
+    Vector<int> _items;
+    int _head;                // Oldest cell
+    int _size;
+    int _mask;                // Capacity - 1
+};
+
+/**
+*  Returns <code>true</code> if the cell's bit is set in the words of a
+*  Grid&lt;bool&gt; with <code>wordsPerRow</code> words per row.
+*/
+inline bool cellMarked(const uint64_t* words, int wordsPerRow, int row, int col) {
+    return (words[row * wordsPerRow + (col >> 6)] >> (col & 63)) & 1;
+}
+
+/**
+*  Sets the cell's bit, and returns <code>false</code> if it was already
+*  set.
+*/
+inline bool markCell(uint64_t* words, int wordsPerRow, int row, int col) {
+    uint64_t& word = words[row * wordsPerRow + (col >> 6)];
+    uint64_t bit = uint64_t(1) << (col & 63);
+    if (word & bit)
+        return false;
+    word |= bit;
+    return true;
+}
+
+/**
+*  Replaces the 4-connected region of cells equal to the one at
+*  <code>row</code>/<code>col</code> with <code>value</code>, and returns
+*  the number of cells changed.  Works a span at a time: each seed is
+*  widened to the whole run of matching cells in its row, the run is
+*  filled, and one seed is pushed per matching run in the rows above and
+*  below.
+*  @throw "Exception" if the position is outside the Grid.
+*/
+template <typename type, typename Layout>
+int flood_fill(Grid<type, Layout>& grid, int row, int col, const type& value) {
+    if (!grid.inBounds(row, col))
+        throw "Exception :-(";
+    type target = grid.get(row, col);
+    if (target == value)
+        return 0;
+
+    int cols = grid.numCols();
+    int filled = 0;
+    Vector<int> seeds;
+    seeds.push_back(row * cols + col);
+    while (!seeds.empty()) {
+        int seed;
+        seeds.pop_back(&seed, 1);
+        int r = seed / cols;
+        int c = seed - r * cols;
+        auto line = grid[r];
+        if (!(line[c] == target))
+            continue;
+
+        int left = c;
+        while (left > 0 && line[left - 1] == target)
+            left--;
+        int right = c;
+        while (right + 1 < cols && line[right + 1] == target)
+            right++;
+        for (int x = left; x <= right; x++)
+            line[x] = value;
+        filled += right - left + 1;
+
+        for (int nr = r - 1; nr <= r + 1; nr += 2) {
+            if (nr < 0 || nr >= grid.numRows())
+                continue;
+            auto next = grid[nr];
+            bool inRun = false;
+            for (int x = left; x <= right; x++) {
+                bool match = next[x] == target;
+                if (match && !inRun)
+                    seeds.push_back(nr * cols + x);
+                inRun = match;
+            }
+        }
+    }
+    return filled;
+}
+
+/**
+*  Returns the number of 4-connected steps from <code>row</code>/
+*  <code>col</code> to every cell, moving only through cells for which
+*  <code>passable(value)</code> is true, or -1 for cells that can not be
+*  reached.
+*  @throw "Exception" if the position is outside the Grid.
+*/
+template <typename type, typename Layout, typename Passable>
+Grid<int> bfs_distances(const Grid<type, Layout>& grid, int row, int col, Passable passable) {
+    if (!grid.inBounds(row, col))
+        throw "Exception :-(";
+    int rows = grid.numRows();
+    int cols = grid.numCols();
+    Grid<int> distance(rows, cols, -1);
+    if (!passable(grid[row][col]))
+        return distance;
+
+    Grid<bool> reached(rows, cols);
+    uint64_t* seen = reached.words();
+    int words = reached.wordsPerRow();
+    int* steps = distance.data();
+    int stride = distance.stride();
+
+    GridFrontier frontier;
+    markCell(seen, words, row, col);
+    steps[row * stride + col] = 0;
+    frontier.push(row * cols + col);
+    while (!frontier.empty()) {
+        int cell = frontier.pop();
+        int r = cell / cols;
+        int c = cell - r * cols;
+        int next = steps[r * stride + c] + 1;
+        const int dr[4] = { -1, 1, 0, 0 };
+        const int dc[4] = { 0, 0, -1, 1 };
+        for (int k = 0; k < 4; k++) {
+            int nr = r + dr[k];
+            int nc = c + dc[k];
+            if (nr < 0 || nr >= rows || nc < 0 || nc >= cols || !markCell(seen, words, nr, nc))
+                continue;
+            if (!passable(grid[nr][nc]))
+                continue;
+            steps[nr * stride + nc] = next;
+            frontier.push(nr * cols + nc);
+        }
+    }
+    return distance;
+}
+
+/**
+*  Returns a cheapest 4-connected path from <code>start</code> to
+*  <code>goal</code>, both included, or an empty Vector if there is none.
+*  Entering a cell costs <code>cost(value)</code>, and a negative cost
+*  makes the cell a wall.  The search is guided by the Manhattan distance
+*  times <code>minCost</code>, which must not exceed the cheapest step for
+*  the path to be optimal.
+*  @throw "Exception" if either position is outside the Grid.
+*/
+template <typename type, typename Layout, typename Cost>
+Vector<GridPoint> a_star(const Grid<type, Layout>& grid, GridPoint start, GridPoint goal,
+                         Cost cost, double minCost = 1.0) {
+    if (!grid.inBounds(start.row, start.col) || !grid.inBounds(goal.row, goal.col))
+        throw "Exception :-(";
+    int rows = grid.numRows();
+    int cols = grid.numCols();
+    Vector<GridPoint> path;
+    if (cost(grid[start.row][start.col]) < 0 || cost(grid[goal.row][goal.col]) < 0)
+        return path;
+
+    struct Node {
+        double f;
+        int cell;
+    };
+    auto heuristic = [&goal, minCost, cols](int cell) {
+        int dr = cell / cols - goal.row;
+        int dc = cell % cols - goal.col;
+        return ((dr < 0 ? -dr : dr) + (dc < 0 ? -dc : dc)) * minCost;
+    };
+
+    const double INF = numeric_limits<double>::infinity();
+    Vector<double> g(rows * cols, INF);
+    Vector<int> parent(rows * cols, -1);
+    Grid<bool> closed(rows, cols);
+    uint64_t* done = closed.words();
+    int words = closed.wordsPerRow();
+    Vector<Node> open;                              // Binary min-heap on f
+
+    int source = start.row * cols + start.col;
+    int target = goal.row * cols + goal.col;
+    g[source] = 0;
+    open.push_back(Node{ heuristic(source), source });
+    while (!open.empty()) {
+        Node best = open[0];                        // Pop the smallest f
+        Node last;
+        open.pop_back(&last, 1);
+        if (!open.empty()) {
+            int i = 0;
+            int n = open.size();
+            while (true) {
+                int child = 2 * i + 1;
+                if (child >= n)
+                    break;
+                if (child + 1 < n && open[child + 1].f < open[child].f)
+                    child++;
+                if (!(open[child].f < last.f))
+                    break;
+                open[i] = open[child];
+                i = child;
+            }
+            open[i] = last;
+        }
+
+        int cell = best.cell;
+        int r = cell / cols;
+        int c = cell - r * cols;
+        if (!markCell(done, words, r, c))
+            continue;
+        if (cell == target)
+            break;
+
+        const int dr[4] = { -1, 1, 0, 0 };
+        const int dc[4] = { 0, 0, -1, 1 };
+        for (int k = 0; k < 4; k++) {
+            int nr = r + dr[k];
+            int nc = c + dc[k];
+            if (nr < 0 || nr >= rows || nc < 0 || nc >= cols || cellMarked(done, words, nr, nc))
+                continue;
+            double step = cost(grid[nr][nc]);
+            if (step < 0)
+                continue;
+            int next = nr * cols + nc;
+            double tentative = g[cell] + step;
+            if (!(tentative < g[next]))
+                continue;
+            g[next] = tentative;
+            parent[next] = cell;
+
+            Node node{ tentative + heuristic(next), next };      // Push, sifting up
+            open.push_back(node);
+            int i = open.size() - 1;
+            while (i > 0 && node.f < open[(i - 1) / 2].f) {
+                open[i] = open[(i - 1) / 2];
+                i = (i - 1) / 2;
+            }
+            open[i] = node;
+        }
+    }
+
+    if (g[target] == INF)
+        return path;
+    int length = 0;
+    for (int cell = target; cell != -1; cell = parent[cell])
+        length++;
+    Vector<GridPoint> reversed(length);
+    int i = length;
+    for (int cell = target; cell != -1; cell = parent[cell])
+        reversed[--i] = GridPoint{ cell / cols, cell % cols };
+    return reversed;
+}
+
+
+#endif // _gridsearch_h
@@ -0,0 +1,219 @@
+#ifndef _gridstencil_h
+#define _gridstencil_h
+
+#include "Grid.h"
+#include "TaskScheduler.h"
+
+using namespace std;
+
+/**
+*  Stencils on row-major Grids: every output cell is computed by a kernel
+*  from the input cells within <code>radius</code> rows and columns of it,
+*  as in cellular automata, blurs and diffusion.
+*
+*  The kernel is called with a cell object and reads its neighbours with
+*  <code>cell(dr, dc)</code>; <code>cell.row()</code> and
+*  <code>cell.col()</code> give its position.  Write it as a generic lambda,
+*  <code>[](const auto& cell) { return cell(-1, 0) + cell(1, 0); }</code>,
+*  because it is instantiated twice: cells at least <code>radius</code>
+*  away from every edge get a <code>StencilInterior</code> that reads
+*  straight from memory, and only the thin border gets a
+*  <code>StencilBorder</code> that applies the <code>Boundary</code> rule.
+*
+*  Passing a <code>TaskScheduler</code> runs bands of rows in parallel.
+*  Every function throws "Exception :-(" if the shapes do not match or the
+*  radius is negative.
+*/
+
+/**
+*  What a neighbour outside the Grid reads as: the nearest edge cell, the
+*  cell on the opposite side, or a constant.
+*/
+enum class Boundary { Clamp, Wrap, Constant };
+
+/**
+*  A cell at least <code>radius</code> away from every edge.
+*/
+template <typename type>
+class StencilInterior {
+public:
+    StencilInterior(const type* center, int stride, int row, int col)
+        : _center(center), _stride(stride), _row(row), _col(col) { }
+
+    const type& operator()(int dr, int dc) const {
+        return _center[dr * _stride + dc];
+    }
+
+    int row() const { return _row; }
+    int col() const { return _col; }
+
+private:
+    const type* _center;
+    int _stride;
+    int _row;
+    int _col;
+};
+
+/**
+*  A cell near an edge, whose neighbours go through the boundary rule.
+*/
+template <typename type>
+class StencilBorder {
+public:
+    StencilBorder(const Grid<type>& grid, Boundary boundary, const type& outside, int row, int col)
+        : _grid(grid), _boundary(boundary), _outside(outside), _row(row), _col(col) { }
+
+    const type& operator()(int dr, int dc) const {
+        int r = _row + dr;
+        int c = _col + dc;
+        int rows = _grid.numRows();
+        int cols = _grid.numCols();
+        if (r < 0 || r >= rows || c < 0 || c >= cols) {
+            switch (_boundary) {
+            case Boundary::Clamp:
+                r = r < 0 ? 0 : (r >= rows ? rows - 1 : r);
+                c = c < 0 ? 0 : (c >= cols ? cols - 1 : c);
+                break;
+            case Boundary::Wrap:
+                r = (r % rows + rows) % rows;
+                c = (c % cols + cols) % cols;
+                break;
+            case Boundary::Constant:
+                return _outside;
+            }
+        }
+        return _grid.data()[r * _grid.stride() + c];
+    }
+
+    int row() const { return _row; }
+    int col() const { return _col; }
+
+private:
+    const Grid<type>& _grid;
+    Boundary _boundary;
+    const type& _outside;
+    int _row;
+    int _col;
+};
+
+/**
+*  Computes row <code>r</code> into <code>target</code>: the border columns
+*  through the boundary rule and the interior columns unchecked.
+*/
+template <typename type, typename Kernel>
+void stencilRow(const Grid<type>& in, type* target, int r, int radius,
+                Kernel& kernel, Boundary boundary, const type& outside) {
+    int rows = in.numRows();
+    int cols = in.numCols();
+
+    int left = cols;                    /// whole row is border unless an interior exists
+    int right = cols;
+    if (r >= radius && r < rows - radius && cols > 2 * radius) {
+        left = radius;
+        right = cols - radius;
+    }
+
+    for (int c = 0; c < left; c++)
+        target[c] = kernel(StencilBorder<type>(in, boundary, outside, r, c));
+    const type* source = in.data() + r * in.stride();
+    for (int c = left; c < right; c++)
+        target[c] = kernel(StencilInterior<type>(source + c, in.stride(), r, c));
+    for (int c = right > left ? right : cols; c < cols; c++)
+        target[c] = kernel(StencilBorder<type>(in, boundary, outside, r, c));
+}
+
+/**
+*  Writes <code>kernel</code> applied to every cell of <code>in</code> into
+*  <code>out</code>, which must have the same shape and be a different
+*  Grid.  With a <code>scheduler</code> the rows are split into bands of
+*  <code>band</code> rows that run in parallel.
+*/
+template <typename type, typename Kernel>
+void stencil(const Grid<type>& in, Grid<type>& out, int radius, Kernel kernel,
+             Boundary boundary = Boundary::Clamp, const type& outside = type(),
+             TaskScheduler* scheduler = nullptr, int band = 16) {
+    if (radius < 0 || &in == &out
+        || in.numRows() != out.numRows() || in.numCols() != out.numCols())
+        throw "Exception :-(";
+    if (in.empty())
+        return;
+
+    int rows = in.numRows();
+    type* block = out.data();           /// marks out dirty once, before any band runs
+    int stride = out.stride();
+    if (scheduler == nullptr) {
+        for (int r = 0; r < rows; r++)
+            stencilRow(in, block + r * stride, r, radius, kernel, boundary, outside);
+        return;
+    }
+
+    if (band < 1)
+        band = 1;
+    int bands = (rows + band - 1) / band;
+    scheduler->parallel_for(0, bands, [&](int b) {
+        int last = (b + 1) * band < rows ? (b + 1) * band : rows;
+        for (int r = b * band; r < last; r++)
+            stencilRow(in, block + r * stride, r, radius, kernel, boundary, outside);
+    });
+}
+
+/**
+*  A double-buffered stencil simulation.  Each <code>step</code> reads the
+*  current Grid and writes the other one, then swaps them, so stepping
+*  never allocates.
+*/
+template <typename type>
+class Stencil {
+public:
+    ///  constructors
+
+    /**
+    *  Starts from <code>initial</code>, with neighbourhoods of
+    *  <code>radius</code> and the given boundary rule.
+    */
+    Stencil(const Grid<type>& initial, int radius = 1,
+            Boundary boundary = Boundary::Clamp, const type& outside = type())
+        : _front(initial), _back(initial.numRows(), initial.numCols()),
+          _radius(radius), _boundary(boundary), _outside(outside) {
+        if (radius < 0)
+            throw "Exception :-(";
+    }
+
+    ///  member function (methods)
+
+    /**
+    *  Advances the simulation by <code>steps</code> applications of
+    *  <code>kernel</code>, in parallel when a <code>scheduler</code> is
+    *  given.
+    */
+    template <typename Kernel>
+    void step(Kernel kernel, int steps = 1, TaskScheduler* scheduler = nullptr) {
+        for (int i = 0; i < steps; i++) {
+            stencil(_front, _back, _radius, kernel, _boundary, _outside, scheduler);
+            swap(_front, _back);
+        }
+    }
+
+    /**
+    *  Returns the Grid holding the latest state.  Changes made to it are
+    *  seen by the next step.
+    */
+    Grid<type>& current() {
+        return _front;
+    }
+
+    const Grid<type>& current() const {
+        return _front;
+    }
+
+private:
+    // member variable (fields)
+    Grid<type> _front;        // Latest state, read by the next step
+    Grid<type> _back;         // Written by the next step
+    int _radius;
+    Boundary _boundary;
+    type _outside;            // Value of cells past the edge for Boundary::Constant
+};
+
+
+#endif // _gridstencil_h
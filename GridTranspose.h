@@ -0,0 +1,245 @@
+#ifndef _gridtranspose_h
+#define _gridtranspose_h
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+/**
+*  Cache-oblivious transposition of row-major blocks, used by
+*  Grid::transpose and the transpose in GridMath.h.
+*
+*  The block is halved along its longer side until a piece fits in cache
+*  whatever the cache size is, and each piece is then moved in B x B
+*  squares by <code>TransposeKernel</code>.  For float (8 x 8) and double
+*  (4 x 4) those squares are transposed inside AVX registers when the
+*  compiler targets AVX; every other type moves them element by element.
+*/
+template <typename type>
+struct TransposeKernel {
+    static const int B = 4;
+
+    /**
+    *  Writes the transpose of the B x B square at <code>s</code> to
+    *  <code>d</code>.
+    */
+    static void copy(const type* s, int lds, type* d, int ldd) {
+        for (int i = 0; i < B; i++)
+            for (int j = 0; j < B; j++)
+                d[j * ldd + i] = s[i * lds + j];
+    }
+
+    /**
+    *  Exchanges the B x B square at <code>p</code> with the transpose of
+    *  the one at <code>q</code>.  The squares must not overlap.
+    */
+    static void swap(type* p, int ldp, type* q, int ldq) {
+        for (int i = 0; i < B; i++) {
+            for (int j = 0; j < B; j++) {
+                type temp = p[i * ldp + j];
+                p[i * ldp + j] = q[j * ldq + i];
+                q[j * ldq + i] = temp;
+            }
+        }
+    }
+};
+
+#if defined(__AVX__)
+
+template <>
+struct TransposeKernel<double> {
+    static const int B = 4;
+
+    static void transpose(__m256d& r0, __m256d& r1, __m256d& r2, __m256d& r3) {
+        __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+        __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+        __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+        __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+        r0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+        r1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+        r2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+        r3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+    }
+
+    static void copy(const double* s, int lds, double* d, int ldd) {
+        __m256d r0 = _mm256_loadu_pd(s);
+        __m256d r1 = _mm256_loadu_pd(s + lds);
+        __m256d r2 = _mm256_loadu_pd(s + 2 * lds);
+        __m256d r3 = _mm256_loadu_pd(s + 3 * lds);
+        transpose(r0, r1, r2, r3);
+        _mm256_storeu_pd(d, r0);
+        _mm256_storeu_pd(d + ldd, r1);
+        _mm256_storeu_pd(d + 2 * ldd, r2);
+        _mm256_storeu_pd(d + 3 * ldd, r3);
+    }
+
+    static void swap(double* p, int ldp, double* q, int ldq) {
+        __m256d p0 = _mm256_loadu_pd(p);
+        __m256d p1 = _mm256_loadu_pd(p + ldp);
+        __m256d p2 = _mm256_loadu_pd(p + 2 * ldp);
+        __m256d p3 = _mm256_loadu_pd(p + 3 * ldp);
+        __m256d q0 = _mm256_loadu_pd(q);
+        __m256d q1 = _mm256_loadu_pd(q + ldq);
+        __m256d q2 = _mm256_loadu_pd(q + 2 * ldq);
+        __m256d q3 = _mm256_loadu_pd(q + 3 * ldq);
+        transpose(p0, p1, p2, p3);
+        transpose(q0, q1, q2, q3);
+        _mm256_storeu_pd(q, p0);
+        _mm256_storeu_pd(q + ldq, p1);
+        _mm256_storeu_pd(q + 2 * ldq, p2);
+        _mm256_storeu_pd(q + 3 * ldq, p3);
+        _mm256_storeu_pd(p, q0);
+        _mm256_storeu_pd(p + ldp, q1);
+        _mm256_storeu_pd(p + 2 * ldp, q2);
+        _mm256_storeu_pd(p + 3 * ldp, q3);
+    }
+};
+
+template <>
+struct TransposeKernel<float> {
+    static const int B = 8;
+
+    static void transpose(__m256* r) {
+        __m256 t[8];
+        __m256 u[8];
+        for (int i = 0; i < 8; i += 2) {
+            t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+            t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+        }
+        for (int i = 0; i < 8; i += 4) {
+            u[i] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+            u[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+            u[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+            u[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+        }
+        for (int i = 0; i < 4; i++) {
+            r[i] = _mm256_permute2f128_ps(u[i], u[i + 4], 0x20);
+            r[i + 4] = _mm256_permute2f128_ps(u[i], u[i + 4], 0x31);
+        }
+    }
+
+    static void copy(const float* s, int lds, float* d, int ldd) {
+        __m256 r[8];
+        for (int i = 0; i < 8; i++)
+            r[i] = _mm256_loadu_ps(s + i * lds);
+        transpose(r);
+        for (int i = 0; i < 8; i++)
+            _mm256_storeu_ps(d + i * ldd, r[i]);
+    }
+
+    static void swap(float* p, int ldp, float* q, int ldq) {
+        __m256 a[8];
+        __m256 b[8];
+        for (int i = 0; i < 8; i++) {
+            a[i] = _mm256_loadu_ps(p + i * ldp);
+            b[i] = _mm256_loadu_ps(q + i * ldq);
+        }
+        transpose(a);
+        transpose(b);
+        for (int i = 0; i < 8; i++) {
+            _mm256_storeu_ps(q + i * ldq, a[i]);
+            _mm256_storeu_ps(p + i * ldp, b[i]);
+        }
+    }
+};
+
+#endif
+
+/**
+*  Writes the transpose of the <code>rows</code> x <code>cols</code> block
+*  at <code>s</code> to the <code>cols</code> x <code>rows</code> block at
+*  <code>d</code>.  The blocks must not overlap.
+*/
+template <typename type>
+void transposeCopy(const type* s, int lds, type* d, int ldd, int rows, int cols) {
+    const int B = TransposeKernel<type>::B;
+    const int LEAF = 32;
+    if (rows > LEAF || cols > LEAF) {
+        if (rows >= cols) {
+            int half = rows / 2 / B * B > 0 ? rows / 2 / B * B : rows / 2;
+            transposeCopy(s, lds, d, ldd, half, cols);
+            transposeCopy(s + half * lds, lds, d + half, ldd, rows - half, cols);
+        } else {
+            int half = cols / 2 / B * B > 0 ? cols / 2 / B * B : cols / 2;
+            transposeCopy(s, lds, d, ldd, rows, half);
+            transposeCopy(s + half, lds, d + half * ldd, ldd, rows, cols - half);
+        }
+        return;
+    }
+
+    int fullRows = rows / B * B;
+    int fullCols = cols / B * B;
+    for (int i = 0; i < fullRows; i += B)
+        for (int j = 0; j < fullCols; j += B)
+            TransposeKernel<type>::copy(s + i * lds + j, lds, d + j * ldd + i, ldd);
+    for (int i = 0; i < rows; i++)                  /// ragged right and bottom edges
+        for (int j = i < fullRows ? fullCols : 0; j < cols; j++)
+            d[j * ldd + i] = s[i * lds + j];
+}
+
+/**
+*  Exchanges the <code>rows</code> x <code>cols</code> block at
+*  <code>p</code> with the transpose of the <code>cols</code> x
+*  <code>rows</code> block at <code>q</code>.  The blocks must not overlap.
+*/
+template <typename type>
+void transposeSwap(type* p, int ldp, type* q, int ldq, int rows, int cols) {
+    const int B = TransposeKernel<type>::B;
+    const int LEAF = 32;
+    if (rows > LEAF || cols > LEAF) {
+        if (rows >= cols) {
+            int half = rows / 2 / B * B > 0 ? rows / 2 / B * B : rows / 2;
+            transposeSwap(p, ldp, q, ldq, half, cols);
+            transposeSwap(p + half * ldp, ldp, q + half, ldq, rows - half, cols);
+        } else {
+            int half = cols / 2 / B * B > 0 ? cols / 2 / B * B : cols / 2;
+            transposeSwap(p, ldp, q, ldq, rows, half);
+            transposeSwap(p + half, ldp, q + half * ldq, ldq, rows, cols - half);
+        }
+        return;
+    }
+
+    int fullRows = rows / B * B;
+    int fullCols = cols / B * B;
+    for (int i = 0; i < fullRows; i += B)
+        for (int j = 0; j < fullCols; j += B)
+            TransposeKernel<type>::swap(p + i * ldp + j, ldp, q + j * ldq + i, ldq);
+    for (int i = 0; i < rows; i++) {
+        for (int j = i < fullRows ? fullCols : 0; j < cols; j++) {
+            type temp = p[i * ldp + j];
+            p[i * ldp + j] = q[j * ldq + i];
+            q[j * ldq + i] = temp;
+        }
+    }
+}
+
+/**
+*  Transposes the <code>n</code> x <code>n</code> block at <code>a</code>
+*  in place: the two diagonal quarters recursively, and the two
+*  off-diagonal quarters by swapping them.
+*/
+template <typename type>
+void transposeSquare(type* a, int lda, int n) {
+    const int B = TransposeKernel<type>::B;
+    const int LEAF = 32;
+    if (n > LEAF) {
+        int half = n / 2 / B * B > 0 ? n / 2 / B * B : n / 2;
+        transposeSquare(a, lda, half);
+        transposeSquare(a + half * lda + half, lda, n - half);
+        transposeSwap(a + half, lda, a + half * lda, lda, half, n - half);
+        return;
+    }
+
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            type temp = a[i * lda + j];
+            a[i * lda + j] = a[j * lda + i];
+            a[j * lda + i] = temp;
+        }
+    }
+}
+
+
+#endif // _gridtranspose_h
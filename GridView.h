@@ -0,0 +1,221 @@
+#ifndef _gridview_h
+#define _gridview_h
+
+#include <iostream>
+#include <type_traits>
+#include "GridLayout.h"
+
+using namespace std;
+
+/**
+*  It is a window onto a rectangle of a Grid that copies nothing: the
+*  Grid's element block, its layout, and the row and column where the
+*  window starts.  Reads and writes through the view go straight to the
+*  Grid, so tile-wise algorithms can work in place on large Grids without
+*  allocating.  Views of views are views of the same Grid.
+*
+*  A view is returned by <code>grid.view(row, col, rows, cols)</code>;
+*  on a const Grid the element type is const and the view is read-only.
+*  It is valid until the Grid is resized, transposed, assigned to or
+*  destroyed.
+*/
+template <typename type, typename Layout = RowMajorLayout>
+class GridView {
+public:
+    class Row;
+
+    /**
+    *  What <code>operator[]</code> returns: a pointer into the row for
+    *  layouts with contiguous rows, otherwise a proxy.
+    */
+    typedef typename conditional<Layout::contiguousRows, type*, Row>::type RowType;
+
+    ///  constructors
+
+    /**
+    *  Initializes a view of the <code>rows</code> x <code>cols</code>
+    *  rectangle starting at <code>row</code>/<code>col</code> of the block
+    *  <code>elements</code> laid out by <code>layout</code>.  Grid::view
+    *  checks the rectangle before calling this.
+    */
+    GridView(type* elements, const Layout* layout, int row, int col, int rows, int cols)
+        : _elements(elements), _layout(layout), _row0(row), _col0(col), _rows(rows), _cols(cols) { }
+
+    ///  member function (methods)
+
+    /**
+    *  Returns the element at the specified <code>row</code>/<code>col</code>
+    *  position in this view.
+    *  @throw "Exception" if the position is outside the view.
+    */
+    type& get(int row, int col) const {
+        if (!inBounds(row, col))
+            throw "Exception :-(";
+        return cell(row, col);
+    }
+
+    /**
+    *  Identical in behavior to get, returning a copy.
+    */
+    typename remove_const<type>::type at(int row, int col) const {
+        return get(row, col);
+    }
+
+    /**
+    *  Replaces the element at the specified <code>row</code>/<code>col</code>.
+    *  @throw "Exception" if the position is outside the view.
+    */
+    template <typename Value>
+    void set(int row, int col, const Value& value) const {
+        get(row, col) = value;
+    }
+
+    /**
+    *  Stores the given value in every cell of the view.
+    */
+    template <typename Value>
+    void fill(const Value& value) const {
+        apply([&value](type& element) { element = value; });
+    }
+
+    /**
+    *  Sets every cell of the view to its element type's default value.
+    */
+    void clear() const {
+        apply([](type& element) { element = type(); });
+    }
+
+    /**
+    *  Calls the specified function on each element of the view.
+    */
+    template <typename Fn>
+    void map(Fn fn) const {
+        apply([&fn](type& element) { element = fn(element); });
+    }
+
+    /**
+    *  Returns the view of the <code>rows</code> x <code>cols</code>
+    *  rectangle starting at <code>row</code>/<code>col</code> of this view.
+    *  @throw "Exception" if it does not fit inside this view.
+    */
+    GridView view(int row, int col, int rows, int cols) const {
+        if (row < 0 || col < 0 || rows < 0 || cols < 0
+            || row + rows > _rows || col + cols > _cols)
+            throw "Exception :-(";
+        return GridView(_elements, _layout, _row0 + row, _col0 + col, rows, cols);
+    }
+
+    /**
+    *  Returns <code>true</code> if the position is inside the view.
+    */
+    bool inBounds(int row, int col) const {
+        return row >= 0 && col >= 0 && row < _rows && col < _cols;
+    }
+
+    /**
+    *  Returns <code>true</code> if the view has 0 rows and/or 0 columns.
+    */
+    bool empty() const {
+        return _rows == 0 || _cols == 0;
+    }
+
+    int numRows() const { return _rows; }
+    int numCols() const { return _cols; }
+    int height() const { return _rows; }
+    int width() const { return _cols; }
+    int size() const { return _rows * _cols; }
+
+    /**
+    *  Returns where the view starts in the Grid.
+    */
+    int rowOffset() const { return _row0; }
+    int colOffset() const { return _col0; }
+
+    /// Operator Overloading
+
+    /**
+    *  Overloads <code>[]</code> so that <code>view[row][col]</code> works
+    *  like it does on a Grid.
+    *  @throw "Exception" if <code>row</code> is outside the view.
+    */
+    RowType operator[](int row) const {
+        if (row < 0 || !(row < _rows))
+            throw "Exception :-(";
+        if constexpr (Layout::contiguousRows)
+            return _elements + _layout->index(_row0 + row, _col0);
+        else
+            return Row(this, row);
+    }
+
+    /**
+    *  The row proxy returned by <code>operator[]</code> for layouts whose
+    *  rows are not contiguous.
+    */
+    class Row {
+    public:
+        Row(const GridView* view, int row) : _view(view), _row(row) { }
+
+        type& operator[](int col) const {
+            return _view->cell(_row, col);
+        }
+
+    private:
+        const GridView* _view;
+        int _row;
+    };
+
+    template <typename T, typename L>
+    friend ostream& operator<<(ostream& out, const GridView<T, L>& view);
+
+private:
+    type& cell(int row, int col) const {
+        return _elements[_layout->index(_row0 + row, _col0 + col)];
+    }
+
+    /**
+    *  Applies <code>fn</code> to every cell, row by row; a row of a
+    *  row-major Grid is walked as one contiguous run.
+    */
+    template <typename Fn>
+    void apply(Fn fn) const {
+        for (int r = 0; r < _rows; r++) {
+            if constexpr (Layout::contiguousRows) {
+                type* run = _elements + _layout->index(_row0 + r, _col0);
+                for (int c = 0; c < _cols; c++)
+                    fn(run[c]);
+            } else {
+                for (int c = 0; c < _cols; c++)
+                    fn(cell(r, c));
+            }
+        }
+    }
+
+    // member variable (fields)
+    type* _elements;          // The Grid's block
+    const Layout* _layout;    // The Grid's layout
+    int _row0;                // Grid row of the view's row 0
+    int _col0;                // Grid column of the view's column 0
+    int _rows;
+    int _cols;
+};
+
+template <typename T, typename L>
+ostream& operator<<(ostream& out, const GridView<T, L>& view) {
+    out << "{ ";
+    for (int i = 0; i < view._rows; i++) {
+        out << "{ ";
+        for (int j = 0; j < view._cols; j++)
+            if (j == view._cols - 1)
+                out << view.cell(i, j);
+            else
+                out << view.cell(i, j) << ",";
+        out << " }";
+        if (i != view._rows - 1)
+            out << "," << endl << "  ";
+    }
+    out << " } ";
+    return out;
+}
+
+
+#endif // _gridview_h
@@ -4,6 +4,8 @@
 #include <iostream>
 #include <vector>
 #include <initializer_list>
+#include <utility>
+#include "Vector.h"
 
 using namespace std;
 
@@ -24,7 +26,7 @@ struct Node {
         }
     };
 
-template <typename type>
+template <typename type, typename Alloc = HeapAllocator<type> >
 class LinkedList {
 public:
     ///  constructors and destructor
@@ -45,6 +47,12 @@ public:
     */
     LinkedList(initializer_list<type> list);
 
+    /**
+    *  Initialization of new empty LinkedList whose nodes are drawn from
+    *  <code>alloc</code>, e.g. an <code>ArenaAllocator</code>
+    */
+    LinkedList(const Alloc& alloc);
+
     /**
     *  Clean up all the memory which are allocated by LinkedList object
     */
@@ -57,6 +65,14 @@ public:
     */
     void push_front(const type& value);
 
+    /**
+    *  Add <code>count</code> elements from <code>values</code> at the start
+    *  of LinkedList, each in front of the one before, exactly as if
+    *  push_front were called on them in turn
+    *  @throw "Exception" if <code>count</code> is less then 0
+    */
+    void push_front(const type* values, int count);
+
     /**
     *  Add element at the end of LinkedList
     */
@@ -68,6 +84,13 @@ public:
     */
     void pop_back();
 
+    /**
+    *  Remove <code>count</code> elements from the end of LinkedList in one
+    *  walk and move them into <code>values</code>, last element first
+    *  @throw "Exception" if <code>count</code> is less then 0 or more than size
+    */
+    void pop_back(type* values, int count);
+
     /**
     *  Remove element from the start of LinkedList
     *  @throw "Exception" if LinkedList is empty
@@ -250,26 +273,38 @@ public:
     /**
     *  Use to print the LinkedList using << operator
     */
-    template <typename T>
-    friend ostream& operator<<(ostream& out, LinkedList<T>& list);
+    template <typename T, typename A>
+    friend ostream& operator<<(ostream& out, LinkedList<T, A>& list);
 
-    template <typename T>
-    friend ostream& operator<<(ostream& out, const LinkedList<T>& list);
+    template <typename T, typename A>
+    friend ostream& operator<<(ostream& out, const LinkedList<T, A>& list);
 
 private:
+    /**
+    *  The allocator for nodes, rebound from the one for values
+    */
+    typedef typename Alloc::template rebind<Node<type> >::other NodeAlloc;
+
+    /**
+    *  Take one node from the allocator, or give one back
+    */
+    Node<type>* newNode(const type& value, Node<type>* next);
+    void freeNode(Node<type>* node);
+
     // member variable (fields)
     Node<type>* start;
     int _size;
+    Alloc _alloc;
 };
 
-template <typename type>
-LinkedList<type>::LinkedList() {
+template <typename type, typename Alloc>
+LinkedList<type, Alloc>::LinkedList() {
     start = nullptr;
     _size = 0;
 }
 
-template <typename type>
-LinkedList<type>::LinkedList(const LinkedList& list) {
+template <typename type, typename Alloc>
+LinkedList<type, Alloc>::LinkedList(const LinkedList& list) : _alloc(list._alloc) {
     _size = 0;
     start = nullptr;
     Node<type>* temp = list.start;
@@ -279,73 +314,130 @@ LinkedList<type>::LinkedList(const LinkedList& list) {
     }
 }
 
-template <typename type>
-LinkedList<type>::LinkedList(LinkedList&& list) {
-    _size = 0;
+template <typename type, typename Alloc>
+LinkedList<type, Alloc>::LinkedList(LinkedList&& list) : _alloc(list._alloc) {
+    _size = list._size;
     start = list.start;
     list.start = nullptr;
+    list._size = 0;
 }
 
-template <typename type>
-LinkedList<type>::LinkedList(initializer_list<type> list) {
+template <typename type, typename Alloc>
+LinkedList<type, Alloc>::LinkedList(initializer_list<type> list) {
     start = nullptr;
     _size = 0;
     for (type i : list)
         push_back(i);
 }
 
-template <typename type>
-LinkedList<type>::~LinkedList() {
+template <typename type, typename Alloc>
+LinkedList<type, Alloc>::LinkedList(const Alloc& alloc) : _alloc(alloc) {
+    start = nullptr;
+    _size = 0;
+}
+
+template <typename type, typename Alloc>
+Node<type>* LinkedList<type, Alloc>::newNode(const type& value, Node<type>* next) {
+    Node<type>* node = NodeAlloc(_alloc).allocate(1);
+    node->data = value;
+    node->next = next;
+    return node;
+}
+
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::freeNode(Node<type>* node) {
+    NodeAlloc(_alloc).deallocate(node, 1);
+}
+
+template <typename type, typename Alloc>
+LinkedList<type, Alloc>::~LinkedList() {
     clear();
 }
 
-template <typename type>
-void LinkedList<type>::push_front(const type& value) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::push_front(const type& value) {
     insert(0, value);
 }
 
-template <typename type>
-void LinkedList<type>::push_back(const type& value) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::push_front(const type* values, int count) {
+    if (count < 0)
+        throw "Exception :-(";
+    for (int i = 0; i < count; i++)
+        start = newNode(values[i], start);
+    _size += count;
+}
+
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::push_back(const type& value) {
     insert(_size, value);
 }
 
-template <typename type>
-void LinkedList<type>::pop_front() {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::pop_front() {
     if (start == nullptr)
         throw "Exception :-(";
     remove(0);
 }
 
-template <typename type>
-void LinkedList<type>::pop_back() {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::pop_back() {
     if (start == nullptr)
         throw "Exception :-(";
     remove(_size - 1);
 }
 
-template <typename type>
-void LinkedList<type>::clear() {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::pop_back(type* values, int count) {
+    if (count < 0 || count > _size)
+        throw "Exception :-(";
+    if (count == 0)
+        return;
+
+    Node<type>* tail;
+    if (count == _size) {
+        tail = start;
+        start = nullptr;
+    } else {
+        Node<type>* last = start;
+        for (int i = 0; i < _size - count - 1; i++)
+            last = last->next;
+        tail = last->next;
+        last->next = nullptr;
+    }
+
+    for (int i = count - 1; i >= 0; i--) {      /// the tail runs front to back
+        Node<type>* trash = tail;
+        values[i] = std::move(tail->data);
+        tail = tail->next;
+        freeNode(trash);
+    }
+    _size -= count;
+}
+
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::clear() {
     Node<type>* trash;
     while (start != nullptr) {
         trash = start;
         start = start->next;
-        delete trash;
+        freeNode(trash);
     }
     _size = 0;
 }
 
-template <typename type>
-bool LinkedList<type>::equals(const LinkedList<type>& list) const {
+template <typename type, typename Alloc>
+bool LinkedList<type, Alloc>::equals(const LinkedList<type, Alloc>& list) const {
     return operator==(list);
 }
 
-template <typename type>
-type LinkedList<type>::at(int index) const {
+template <typename type, typename Alloc>
+type LinkedList<type, Alloc>::at(int index) const {
     return operator[](index);
 }
 
-template <typename type>
-int LinkedList<type>::contain(const type& value) const {
+template <typename type, typename Alloc>
+int LinkedList<type, Alloc>::contain(const type& value) const {
     Node<type>* temp = start;
     for (int i = 0; i < _size; i++) {
         if (temp->data == value)
@@ -355,35 +447,35 @@ int LinkedList<type>::contain(const type& value) const {
     return -1;
 }
 
-template <typename type>
-void LinkedList<type>::insert(int index, const type& value) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::insert(int index, const type& value) {
     if (index > _size || index < 0)
         throw "Exception :-(";
     else if (start == nullptr) {
-        Node<type>* newNode = new Node<type>(value);
-        start = newNode;
+        Node<type>* node = newNode(value, nullptr);
+        start = node;
         _size++;
     } else if (index == 0) {
-        Node<type>* newNode = new Node<type>(value, start);
-        start = newNode;
+        Node<type>* node = newNode(value, start);
+        start = node;
         _size++;
     } else {
         Node<type>* temp = start;
         for (int i = 0; i < index - 1; i++)
             temp = temp->next;
-        Node<type>* newNode = new Node<type>(value,temp->next);
-        temp->next = newNode;
+        Node<type>* node = newNode(value,temp->next);
+        temp->next = node;
         _size++;
     }
 }
 
-template <typename type>
-bool LinkedList<type>::empty() const {
+template <typename type, typename Alloc>
+bool LinkedList<type, Alloc>::empty() const {
     return !_size;
 }
 
-template <typename type>
-void LinkedList<type>::remove(int index) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::remove(int index) {
     if (index >= _size || index < 0)
         throw "Exception :-(";
     else if (start == nullptr)
@@ -391,7 +483,7 @@ void LinkedList<type>::remove(int index) {
     else if (index == 0) {
         Node<type>* trash = start;
         start = start->next;
-        delete trash;
+        freeNode(trash);
         _size--;
     } else {
         Node<type>* temp = start;
@@ -400,13 +492,13 @@ void LinkedList<type>::remove(int index) {
             temp = temp->next;
         trash = temp->next;
         temp->next = trash->next;
-        delete trash;
+        freeNode(trash);
         _size--;
     }
 }
 
-template <typename type>
-void LinkedList<type>::set(int index, const type& value) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::set(int index, const type& value) {
     if(index < 0 || index + 1 > _size)
         throw "Exception :-(";
     Node<type>* temp = start;
@@ -415,27 +507,27 @@ void LinkedList<type>::set(int index, const type& value) {
     temp->data = value;
 }
 
-template <typename type>
-int LinkedList<type>::size() const {
+template <typename type, typename Alloc>
+int LinkedList<type, Alloc>::size() const {
     return _size;
 }
 
-template <typename type>
-type& LinkedList<type>::front() {
+template <typename type, typename Alloc>
+type& LinkedList<type, Alloc>::front() {
     if (start == nullptr)
         throw "Exception :-(";
     return start->data;
 }
 
-template <typename type>
-const type& LinkedList<type>::front() const {
+template <typename type, typename Alloc>
+const type& LinkedList<type, Alloc>::front() const {
     if (start == nullptr)
         throw "Exception :-(";
     return start->data;
 }
 
-template <typename type>
-type& LinkedList<type>::back() {
+template <typename type, typename Alloc>
+type& LinkedList<type, Alloc>::back() {
     if (start == nullptr)
         throw "Exception :-(";
     Node<type>* temp = start;
@@ -445,8 +537,8 @@ type& LinkedList<type>::back() {
     return temp->data;
 }
 
-template <typename type>
-const type& LinkedList<type>::back() const {
+template <typename type, typename Alloc>
+const type& LinkedList<type, Alloc>::back() const {
     if (start == nullptr)
         throw "Exception :-(";
     Node<type>* temp = start;
@@ -456,8 +548,8 @@ const type& LinkedList<type>::back() const {
     return temp->data;
 }
 
-template <typename type>
-void LinkedList<type>::swap(LinkedList& list) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::swap(LinkedList& list) {
     Node<type>* temp_start= start;
     int temp_size = _size;
 
@@ -466,11 +558,15 @@ void LinkedList<type>::swap(LinkedList& list) {
 
     list.start = temp_start;
     list._size = temp_size;
+
+    Alloc temp_alloc = _alloc;
+    _alloc = list._alloc;
+    list._alloc = temp_alloc;
 }
 
-template <typename type>
-LinkedList<type> LinkedList<type>::subList(int start, int length) {
-    LinkedList<type> list;
+template <typename type, typename Alloc>
+LinkedList<type, Alloc> LinkedList<type, Alloc>::subList(int start, int length) {
+    LinkedList<type, Alloc> list(_alloc);
     if (start > _size || start + length > _size || start < 0 || length < 0)
         throw "Exception :-(";
     else {
@@ -480,13 +576,13 @@ LinkedList<type> LinkedList<type>::subList(int start, int length) {
     return list;
 }
 
-template <typename type>
-LinkedList<type> LinkedList<type>::subList(int start) {
+template <typename type, typename Alloc>
+LinkedList<type, Alloc> LinkedList<type, Alloc>::subList(int start) {
     return subList(start, _size - start);
 }
 
-template <typename type>
-void LinkedList<type>::map(int (*fn)(type)) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::map(int (*fn)(type)) {
     Node<type>* temp = start;
     while (temp != nullptr) {
         temp->data = fn(temp->data);
@@ -494,8 +590,8 @@ void LinkedList<type>::map(int (*fn)(type)) {
     }
 }
 
-template <typename type>
-void LinkedList<type>::map(int (*fn)(type&)) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::map(int (*fn)(type&)) {
     Node<type>* temp = start;
     for (int i = 0; i < _size; i++) {
         temp->data = fn(temp->data);
@@ -503,8 +599,8 @@ void LinkedList<type>::map(int (*fn)(type&)) {
     }
 }
 
-template <typename type>
-void LinkedList<type>::map(int (*fn)(const type&)) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::map(int (*fn)(const type&)) {
     Node<type>* temp = start;
     for (int i = 0; i < _size; i++) {
         temp->data = fn(temp->data);
@@ -512,8 +608,8 @@ void LinkedList<type>::map(int (*fn)(const type&)) {
     }
 }
 
-template <typename type>
-void LinkedList<type>::addAll(const LinkedList& list) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::addAll(const LinkedList& list) {
     Node<type>* temp = start;
     while (temp->next != nullptr)
         temp = temp->next;
@@ -521,8 +617,8 @@ void LinkedList<type>::addAll(const LinkedList& list) {
     _size += list._size;
 }
 
-template <typename type>
-void LinkedList<type>::addAll(int index, const LinkedList& list) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::addAll(int index, const LinkedList& list) {
     if (index > _size || index < 0)
         throw "Exception :-(";
     else {
@@ -538,8 +634,8 @@ void LinkedList<type>::addAll(int index, const LinkedList& list) {
     }
 }
 
-template <typename type>
-void LinkedList<type>::removeAll(int index, int length) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::removeAll(int index, int length) {
     vector<Node<type>*> tresh;
     Node<type>* first;
     Node<type>* temp = start;
@@ -555,16 +651,16 @@ void LinkedList<type>::removeAll(int index, int length) {
         }
         first->next = temp;
         for (Node<type>* n : tresh)
-            delete n;
+            freeNode(n);
 }
 
-template <typename type>
-void LinkedList<type>::removeAll(int index) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::removeAll(int index) {
     removeAll(index, _size - index);
 }
 
-template <typename type>
-void LinkedList<type>::sort() {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::sort() {
     type temp1;
     Node<type>* temp2 = start;
     bool flag = true;
@@ -585,8 +681,8 @@ void LinkedList<type>::sort() {
     }
 }
 
-template <typename type>
-type& LinkedList<type>::operator[](int index) {
+template <typename type, typename Alloc>
+type& LinkedList<type, Alloc>::operator[](int index) {
     if (index >= _size || index < 0)
         throw "Exception :-(";
     else {
@@ -598,8 +694,8 @@ type& LinkedList<type>::operator[](int index) {
     }
 }
 
-template <typename type>
-const type& LinkedList<type>::operator[](int index) const {
+template <typename type, typename Alloc>
+const type& LinkedList<type, Alloc>::operator[](int index) const {
     if (index >= _size || index < 0)
         throw "Exception :-(";
     else {
@@ -611,8 +707,8 @@ const type& LinkedList<type>::operator[](int index) const {
     }
 }
 
-template <typename type>
-LinkedList<type>& LinkedList<type>::operator=(const LinkedList& list) {
+template <typename type, typename Alloc>
+LinkedList<type, Alloc>& LinkedList<type, Alloc>::operator=(const LinkedList& list) {
     if (this != &list) {
         Node<type>* temp = list.start;
         while (temp != nullptr) {
@@ -623,15 +719,21 @@ LinkedList<type>& LinkedList<type>::operator=(const LinkedList& list) {
     return *this;
 }
 
-template <typename type>
-LinkedList<type>& LinkedList<type>::operator=(LinkedList&& list) {
-    start = list.start;
-    list.start = nullptr;
+template <typename type, typename Alloc>
+LinkedList<type, Alloc>& LinkedList<type, Alloc>::operator=(LinkedList&& list) {
+    if (this != &list) {
+        clear();
+        _alloc = list._alloc;
+        start = list.start;
+        _size = list._size;
+        list.start = nullptr;
+        list._size = 0;
+    }
     return *this;
 }
 
-template <typename type>
-bool LinkedList<type>::operator==(const LinkedList& list) const {
+template <typename type, typename Alloc>
+bool LinkedList<type, Alloc>::operator==(const LinkedList& list) const {
     Node<type>* temp1 = start;
     Node<type>* temp2 = list.start;
     if (_size == list._size) {
@@ -646,13 +748,13 @@ bool LinkedList<type>::operator==(const LinkedList& list) const {
     return false;
 }
 
-template <typename type>
-bool LinkedList<type>::operator!=(const LinkedList& list) const {
+template <typename type, typename Alloc>
+bool LinkedList<type, Alloc>::operator!=(const LinkedList& list) const {
     return !(operator==(list));
 }
 
-template <typename type>
-bool LinkedList<type>::operator<(const LinkedList& list) const {
+template <typename type, typename Alloc>
+bool LinkedList<type, Alloc>::operator<(const LinkedList& list) const {
    Node<type>* temp1 = start;
     Node<type>* temp2 = list.start;
     if (_size == list._size) {
@@ -667,8 +769,8 @@ bool LinkedList<type>::operator<(const LinkedList& list) const {
     return false;
 }
 
-template <typename type>
-bool LinkedList<type>::operator<=(const LinkedList& list) const {
+template <typename type, typename Alloc>
+bool LinkedList<type, Alloc>::operator<=(const LinkedList& list) const {
      Node<type>* temp1 = start;
     Node<type>* temp2 = list.start;
     if (_size == list._size) {
@@ -683,8 +785,8 @@ bool LinkedList<type>::operator<=(const LinkedList& list) const {
     return false;
 }
 
-template <typename type>
-bool LinkedList<type>::operator>(const LinkedList& list) const {
+template <typename type, typename Alloc>
+bool LinkedList<type, Alloc>::operator>(const LinkedList& list) const {
     Node<type>* temp1 = start;
     Node<type>* temp2 = list.start;
     if (_size == list._size) {
@@ -699,8 +801,8 @@ bool LinkedList<type>::operator>(const LinkedList& list) const {
     return false;
 }
 
-template <typename type>
-bool LinkedList<type>::operator>=(const LinkedList& list) const {
+template <typename type, typename Alloc>
+bool LinkedList<type, Alloc>::operator>=(const LinkedList& list) const {
      Node<type>* temp1 = start;
     Node<type>* temp2 = list.start;
     if (_size == list._size) {
@@ -715,9 +817,9 @@ bool LinkedList<type>::operator>=(const LinkedList& list) const {
     return false;
 }
 
-template <typename type>
-LinkedList<type> LinkedList<type>::operator+(LinkedList& list) {
-    LinkedList<type> list1;
+template <typename type, typename Alloc>
+LinkedList<type, Alloc> LinkedList<type, Alloc>::operator+(LinkedList& list) {
+    LinkedList<type, Alloc> list1(_alloc);
     Node<type>* temp = start;
     while (temp != nullptr) {
         list1.push_back(temp->data);
@@ -730,9 +832,9 @@ LinkedList<type> LinkedList<type>::operator+(LinkedList& list) {
     return list1;
 }
 
-template <typename type>
-LinkedList<type> LinkedList<type>::operator+(const type& value) {
-    LinkedList<type> list;
+template <typename type, typename Alloc>
+LinkedList<type, Alloc> LinkedList<type, Alloc>::operator+(const type& value) {
+    LinkedList<type, Alloc> list(_alloc);
     Node<type>* temp = start;
     while (temp != nullptr) {
         list.push_back(temp->data);
@@ -742,21 +844,21 @@ LinkedList<type> LinkedList<type>::operator+(const type& value) {
     return list;
 }
 
-template <typename type>
-void LinkedList<type>::operator+=(const LinkedList& list) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::operator+=(const LinkedList& list) {
     addAll(list);
 }
 
-template <typename type>
-void LinkedList<type>::operator+=(const type& value) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::operator+=(const type& value) {
     push_back(value);
 }
 
-template <typename type>
-LinkedList<type> LinkedList<type>::operator-(const type& value) {
-    LinkedList<type> list;
+template <typename type, typename Alloc>
+LinkedList<type, Alloc> LinkedList<type, Alloc>::operator-(const type& value) {
+    LinkedList<type, Alloc> list(_alloc);
     Node<type>* temp = start;
-    Node<type>* trash;
+    Node<type>* trash = nullptr;
     while (temp != nullptr) {
         list.push_back(temp->data);
         temp = temp->next;
@@ -769,20 +871,20 @@ LinkedList<type> LinkedList<type>::operator-(const type& value) {
         }
         temp = temp->next;
     }
-    delete trash;
+    list.freeNode(trash);
     return list;
 }
 
-template <typename type>
-void LinkedList<type>::operator-=(const type& value) {
+template <typename type, typename Alloc>
+void LinkedList<type, Alloc>::operator-=(const type& value) {
     int val = contain(value);
     if (val != -1)
         remove(val);
 }
 
-template <typename type>
-LinkedList<type> LinkedList<type>::operator-() {
-    LinkedList<type> list;
+template <typename type, typename Alloc>
+LinkedList<type, Alloc> LinkedList<type, Alloc>::operator-() {
+    LinkedList<type, Alloc> list(_alloc);
     Node<type>* temp = start;
     while (temp != nullptr) {
         list.push_back(-temp->data);
@@ -791,8 +893,8 @@ LinkedList<type> LinkedList<type>::operator-() {
     return list;
 }
 
-template <typename type>
-ostream& operator<<(ostream& out, LinkedList<type>& list) {
+template <typename type, typename Alloc>
+ostream& operator<<(ostream& out, LinkedList<type, Alloc>& list) {
     Node<type>* temp = list.start;
     out << "{ ";
     while (temp != nullptr) {
@@ -806,8 +908,8 @@ ostream& operator<<(ostream& out, LinkedList<type>& list) {
     return out;
 }
 
-template <typename type>
-ostream& operator<<(ostream& out, const LinkedList<type>& list) {
+template <typename type, typename Alloc>
+ostream& operator<<(ostream& out, const LinkedList<type, Alloc>& list) {
     Node<type>* temp = list.start;
     out << "{ ";
     while (temp != nullptr) {
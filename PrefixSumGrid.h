@@ -0,0 +1,274 @@
+#ifndef _prefixsumgrid_h
+#define _prefixsumgrid_h
+
+#include <type_traits>
+#include "Grid.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+/**
+*  The type rectangle sums of <code>type</code> are accumulated in: long
+*  long for integers, so that a large Grid of ints does not overflow, and
+*  the type itself otherwise.
+*/
+template <typename type>
+using PrefixSumType = typename conditional<is_integral<type>::value, long long, type>::type;
+
+/**
+*  Writes the running sums of <code>source[0..count)</code> to
+*  <code>target</code>, starting from 0.  For double and for int summed
+*  into long long this is done four lanes at a time in AVX2 registers
+*  when the compiler targets AVX2.
+*/
+template <typename type, typename Sum>
+struct RowScan {
+    static void scan(const type* source, Sum* target, int count) {
+        Sum running = Sum();
+        for (int c = 0; c < count; c++) {
+            running += source[c];
+            target[c] = running;
+        }
+    }
+};
+
+#if defined(__AVX2__)
+
+template <>
+struct RowScan<double, double> {
+    static void scan(const double* source, double* target, int count) {
+        __m256d zero = _mm256_setzero_pd();
+        __m256d carry = zero;
+        int c = 0;
+        for (; c + 4 <= count; c += 4) {
+            __m256d v = _mm256_loadu_pd(source + c);
+            v = _mm256_add_pd(v, _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x1));
+            v = _mm256_add_pd(v, _mm256_permute2f128_pd(v, v, 0x08));
+            v = _mm256_add_pd(v, carry);
+            _mm256_storeu_pd(target + c, v);
+            carry = _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 3, 3, 3));
+        }
+        double running = c > 0 ? target[c - 1] : 0.0;
+        for (; c < count; c++) {
+            running += source[c];
+            target[c] = running;
+        }
+    }
+};
+
+template <>
+struct RowScan<int, long long> {
+    static void scan(const int* source, long long* target, int count) {
+        __m256i zero = _mm256_setzero_si256();
+        __m256i carry = zero;
+        int c = 0;
+        for (; c + 4 <= count; c += 4) {
+            __m256i v = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + c)));
+            v = _mm256_add_epi64(v, _mm256_blend_epi32(_mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x03));
+            v = _mm256_add_epi64(v, _mm256_permute2x128_si256(v, v, 0x08));
+            v = _mm256_add_epi64(v, carry);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + c), v);
+            carry = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 3, 3, 3));
+        }
+        long long running = c > 0 ? target[c - 1] : 0;
+        for (; c < count; c++) {
+            running += source[c];
+            target[c] = running;
+        }
+    }
+};
+
+#endif
+
+/**
+*  A summed-area table over a row-major Grid: cell
+*  <code>(r, c)</code> of the table holds the sum of every cell above and
+*  to the left of <code>(r, c)</code> in the Grid, so the sum of any
+*  rectangle is four lookups.  It is built in one pass, each row scanned
+*  and then added to the row above.
+*
+*  The table is a snapshot: changes to the Grid are not seen.  Use
+*  FenwickGrid when cells change between queries.
+*/
+template <typename type, typename Sum = PrefixSumType<type> >
+class PrefixSumGrid {
+public:
+    ///  constructors
+
+    /**
+    *  Initializes an empty table.
+    */
+    PrefixSumGrid() : _table(1, 1) { }
+
+    /**
+    *  Builds the table for <code>grid</code>.
+    */
+    explicit PrefixSumGrid(const Grid<type>& grid) {
+        build(grid);
+    }
+
+    ///  member function (methods)
+
+    /**
+    *  Rebuilds the table for <code>grid</code>.
+    */
+    void build(const Grid<type>& grid) {
+        int rows = grid.numRows();
+        int cols = grid.numCols();
+        _table.resize(rows + 1, cols + 1);
+        for (int r = 0; r < rows; r++) {
+            const Sum* above = _table[r] + 1;
+            Sum* row = _table[r + 1] + 1;
+            RowScan<type, Sum>::scan(grid[r], row, cols);
+            for (int c = 0; c < cols; c++)
+                row[c] += above[c];
+        }
+    }
+
+    /**
+    *  Returns the sum of the <code>rows</code> x <code>cols</code>
+    *  rectangle starting at <code>row</code>/<code>col</code>, in O(1).
+    *  @throw "Exception" if the rectangle does not fit inside the Grid.
+    */
+    Sum sum(int row, int col, int rows, int cols) const {
+        if (row < 0 || col < 0 || rows < 0 || cols < 0
+            || row + rows > numRows() || col + cols > numCols())
+            throw "Exception :-(";
+        const Sum* top = _table[row];
+        const Sum* bottom = _table[row + rows];
+        return bottom[col + cols] - bottom[col] - top[col + cols] + top[col];
+    }
+
+    /**
+    *  Returns the sum of the whole Grid.
+    */
+    Sum total() const {
+        return _table[numRows()][numCols()];
+    }
+
+    int numRows() const { return _table.numRows() - 1; }
+    int numCols() const { return _table.numCols() - 1; }
+
+private:
+    // member variable (fields)
+    Grid<Sum> _table;         // (rows + 1) x (cols + 1), row and column 0 are zero
+};
+
+/**
+*  A two-dimensional Fenwick (binary indexed) tree: rectangle sums in
+*  O(log rows * log cols), like PrefixSumGrid, but cells can also be
+*  changed in O(log rows * log cols) between queries.
+*/
+template <typename type, typename Sum = PrefixSumType<type> >
+class FenwickGrid {
+public:
+    ///  constructors
+
+    /**
+    *  Initializes a <code>row</code> x <code>column</code> tree of zeros.
+    */
+    FenwickGrid(int row = 0, int column = 0) : _values(row, column), _tree(row + 1, column + 1) { }
+
+    /**
+    *  Builds the tree for <code>grid</code> in O(rows * cols), by adding
+    *  every node into its parent along each axis.
+    */
+    explicit FenwickGrid(const Grid<type>& grid)
+        : _values(grid), _tree(grid.numRows() + 1, grid.numCols() + 1) {
+        int rows = numRows();
+        int cols = numCols();
+        for (int r = 1; r <= rows; r++) {
+            Sum* row = _tree[r];
+            for (int c = 1; c <= cols; c++)
+                row[c] = grid[r - 1][c - 1];
+            for (int c = 1; c <= cols; c++) {
+                int parent = c + (c & -c);
+                if (parent <= cols)
+                    row[parent] += row[c];
+            }
+        }
+        for (int r = 1; r <= rows; r++) {
+            int parent = r + (r & -r);
+            if (parent > rows)
+                continue;
+            const Sum* source = _tree[r];
+            Sum* target = _tree[parent];
+            for (int c = 1; c <= cols; c++)
+                target[c] += source[c];
+        }
+    }
+
+    ///  member function (methods)
+
+    /**
+    *  Adds <code>delta</code> to the cell at <code>row</code>/<code>col</code>.
+    *  @throw "Exception" if the position is outside the Grid.
+    */
+    void add(int row, int col, const type& delta) {
+        if (!_values.inBounds(row, col))
+            throw "Exception :-(";
+        _values[row][col] += delta;
+        for (int r = row + 1; r <= numRows(); r += r & -r) {
+            Sum* node = _tree[r];
+            for (int c = col + 1; c <= numCols(); c += c & -c)
+                node[c] += delta;
+        }
+    }
+
+    /**
+    *  Replaces the cell at <code>row</code>/<code>col</code>.
+    *  @throw "Exception" if the position is outside the Grid.
+    */
+    void set(int row, int col, const type& value) {
+        add(row, col, value - _values.get(row, col));
+    }
+
+    /**
+    *  Returns the cell at <code>row</code>/<code>col</code>.
+    *  @throw "Exception" if the position is outside the Grid.
+    */
+    type get(int row, int col) const {
+        return _values.get(row, col);
+    }
+
+    /**
+    *  Returns the sum of the <code>rows</code> x <code>cols</code>
+    *  rectangle starting at <code>row</code>/<code>col</code>.
+    *  @throw "Exception" if the rectangle does not fit inside the Grid.
+    */
+    Sum sum(int row, int col, int rows, int cols) const {
+        if (row < 0 || col < 0 || rows < 0 || cols < 0
+            || row + rows > numRows() || col + cols > numCols())
+            throw "Exception :-(";
+        return prefix(row + rows, col + cols) - prefix(row, col + cols)
+             - prefix(row + rows, col) + prefix(row, col);
+    }
+
+    int numRows() const { return _values.numRows(); }
+    int numCols() const { return _values.numCols(); }
+
+private:
+    /**
+    *  Returns the sum of the first <code>rows</code> rows and
+    *  <code>cols</code> columns.
+    */
+    Sum prefix(int rows, int cols) const {
+        Sum total = Sum();
+        for (int r = rows; r > 0; r -= r & -r) {
+            const Sum* node = _tree[r];
+            for (int c = cols; c > 0; c -= c & -c)
+                total += node[c];
+        }
+        return total;
+    }
+
+    // member variable (fields)
+    Grid<type> _values;       // The cells themselves, for get and set
+    Grid<Sum> _tree;          // 1-based tree nodes, row and column 0 unused
+};
+
+
+#endif // _prefixsumgrid_h
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <initializer_list>
 #include "LinkedList.h"
+#include "Vector.h"
 
 using namespace std;
 
@@ -15,7 +16,7 @@ using namespace std;
  * operations are <code>push</code> (add to front) and <code>pop</code>
  * (remove from back).
  */
-template <typename type>
+template <typename type, typename Alloc = HeapAllocator<type> >
 class Queue {
 
 public:
@@ -43,6 +44,12 @@ public:
     */
     Queue(initializer_list<type> queue) : _elements(queue) { }
 
+    /**
+    *  Initializes a new empty queue whose storage is drawn from
+    *  <code>alloc</code>, e.g. an <code>ArenaAllocator</code>.
+    */
+    Queue(const Alloc& alloc) : _elements(alloc) { }
+
     /**
     *  Frees any heap storage associated with this queue.
     */
@@ -96,6 +103,35 @@ public:
     */
     void enqueue(const type& value) {
         _elements.push_front(value);
+    }
+
+    /**
+    *  Adds <code>count</code> values from <code>values</code> to the queue
+    *  in order, so <code>values[0]</code> is dequeued first.  The whole
+    *  block is linked in with one bounds check.
+    *  @throw "Exception" if <code>count</code> is less then 0
+    */
+    void enqueue_range(const type* values, int count) {
+        _elements.push_front(values, count);
+    }
+
+    void enqueue_range(const Vector<type>& values) {
+        if (!values.empty())
+            _elements.push_front(&values[0], values.size());
+    }
+
+    /**
+    *  Removes the next <code>count</code> items from the queue in a single
+    *  walk and returns them in the order dequeue would.
+    *  @throw "Exception" if the queue has fewer than <code>count</code> items
+    */
+    Vector<type> dequeue_n(int count) {
+        if (count < 0 || count > size())
+            throw "Exception :-(";
+        Vector<type> values(count);
+        if (count > 0)
+            _elements.pop_back(&values[0], count);
+        return values;
     }
 
     /**
@@ -104,7 +140,7 @@ public:
     *  values as the given other queue.
     *  Identical in behavior to the == operator.
     */
-    bool equals(const Queue<type>& queue) const {
+    bool equals(const Queue& queue) const {
         return _elements.equals(queue._elements);
     }
 
@@ -140,7 +176,7 @@ public:
         return _elements.size();
     }
 
-    void swap(Queue<type>& queue) {
+    void swap(Queue& queue) {
         _elements.swap(queue._elements);
     }
 
@@ -213,7 +249,7 @@ public:
     *  A synonym for the enqueue method. But you can use as an operator.
     */
     Queue operator+(const type& value) {
-        Queue<type> queue;
+        Queue queue;
         queue._elements.addAll(_elements);
         enqueue(value);
         return queue;
@@ -223,26 +259,26 @@ public:
         enqueue(value);
     }
 
-    template <typename T>
-    friend ostream& operator<<(ostream& out, Queue<T>& queue);
+    template <typename T, typename A>
+    friend ostream& operator<<(ostream& out, Queue<T, A>& queue);
 
-    template <typename T>
-    friend ostream& operator<<(ostream& out, const Queue<T>& queue);
+    template <typename T, typename A>
+    friend ostream& operator<<(ostream& out, const Queue<T, A>& queue);
 
 private:
     // member variable (fields)
-    LinkedList<type> _elements;
+    LinkedList<type, Alloc> _elements;
 };
 
 
-template <typename type>
- ostream& operator<<(ostream& out, Queue<type>& queue) {
+template <typename type, typename Alloc>
+ ostream& operator<<(ostream& out, Queue<type, Alloc>& queue) {
     out << queue._elements;
     return out;
  }
 
- template <typename type>
- ostream& operator<<(ostream& out, const Queue<type>& queue) {
+ template <typename type, typename Alloc>
+ ostream& operator<<(ostream& out, const Queue<type, Alloc>& queue) {
     out << queue._elements;
     return out;
  }
@@ -0,0 +1,267 @@
+#ifndef _segmentedstack_h
+#define _segmentedstack_h
+
+#include <iostream>
+#include <utility>
+#include <initializer_list>
+#include "Vector.h"
+
+using namespace std;
+
+/**
+ * This class models a stack, like <code>Stack</code>, whose elements live
+ * in a chain of fixed-size chunks instead of one growing array.  When the
+ * top chunk fills up a new one is linked on top; existing elements are
+ * never copied or moved, so push latency stays flat at any depth and
+ * references to elements stay valid until they are popped.
+ *
+ * The stack keeps one empty chunk in reserve when it shrinks, so pushing
+ * and popping back and forth across a chunk boundary does not allocate.
+ */
+template <typename type, int chunkSize = 256>
+class SegmentedStack {
+public:
+    ///  constructors and destructor
+
+    /**
+    *  Initializes a new empty stack.
+    */
+    SegmentedStack() {
+        _top = nullptr;
+        _spare = nullptr;
+        _used = chunkSize;
+        _size = 0;
+    }
+
+    /**
+    *  Copy Constructor - use the passed stack to initialization itself (deep copy)
+    *  Take Constructor - takes over the chunks of the passed stack
+    */
+    SegmentedStack(const SegmentedStack& stack) : SegmentedStack() {     ///Copy Constructor
+        copy(stack);
+    }
+
+    SegmentedStack(SegmentedStack&& stack) : SegmentedStack() {          ///Take Constructor
+        swap(stack);
+    }
+
+    /**
+    *  Create a stack using initializer list
+    */
+    SegmentedStack(initializer_list<type> stack) : SegmentedStack() {
+        for (const type& value : stack)
+            push(value);
+    }
+
+    /**
+    *  Frees every chunk, including the spare one.
+    */
+    virtual ~SegmentedStack() {
+        release();
+    }
+
+    ///  member function (methods)
+
+    /**
+    *  Pushes the specified value onto the top of this stack.
+    */
+    void push(const type& value) {
+        slot() = value;
+        _used++;
+        _size++;
+    }
+
+    void push(type&& value) {
+        slot() = std::move(value);
+        _used++;
+        _size++;
+    }
+
+    /**
+    *  Builds a new value from <code>args</code> on the top of this stack.
+    */
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        slot() = type(std::forward<Args>(args)...);
+        _used++;
+        _size++;
+    }
+
+    /**
+    *  Removes the top element from this stack and returns it.
+    *  @throw "Exception" if stack is empty
+    */
+    type pop() {
+        if (empty())
+            throw "Exception :-(";
+        type element = std::move(_top->items[--_used]);
+        _size--;
+        if (_used == 0 && _top->below != nullptr) {   /// top chunk is empty
+            Chunk* empty = _top;
+            _top = _top->below;
+            _used = chunkSize;
+            delete _spare;
+            empty->below = nullptr;
+            _spare = empty;
+        }
+        return element;
+    }
+
+    /**
+    *  Returns the value of top element from this stack, without removing it.
+    *  @throw "Exception" if stack is empty
+    */
+    type peek() const {
+        return top();
+    }
+
+    /**
+    *  Returns the top element of this stack by reference.  The reference
+    *  stays valid until the element is popped.
+    *  @throw "Exception" if stack is empty
+    */
+    type& top() {
+        if (empty())
+            throw "Exception :-(";
+        return _top->items[_used - 1];
+    }
+
+    const type& top() const {
+        if (empty())
+            throw "Exception :-(";
+        return _top->items[_used - 1];
+    }
+
+    /**
+    *  Removes all elements from this stack and frees their chunks.
+    */
+    void clear() {
+        release();
+        _top = nullptr;
+        _spare = nullptr;
+        _used = chunkSize;
+        _size = 0;
+    }
+
+    /**
+    *  Returns <code>true</code> if this stack contains no elements.
+    */
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+    *  Returns the number of values in this stack.
+    */
+    int size() const {
+        return _size;
+    }
+
+    /**
+    *  Swap the two stacks
+    */
+    void swap(SegmentedStack& stack) {
+        std::swap(_top, stack._top);
+        std::swap(_spare, stack._spare);
+        std::swap(_used, stack._used);
+        std::swap(_size, stack._size);
+    }
+
+    /// Operator Overloading
+
+    /**
+     * Overloads = to assign new stack to left stack
+     */
+    SegmentedStack& operator=(const SegmentedStack& stack) {   ///Copy assignment operator
+        if (this != &stack) {
+            clear();
+            copy(stack);
+        }
+        return *this;
+    }
+
+    SegmentedStack& operator=(SegmentedStack&& stack) {        ///Take assignment operator
+        if (this != &stack)
+            swap(stack);
+        return *this;
+    }
+
+    template <typename T, int N>
+    friend ostream& operator<<(ostream& out, const SegmentedStack<T, N>& stack);
+
+private:
+    struct Chunk {
+        type items[chunkSize];
+        Chunk* below = nullptr;
+    };
+
+    /**
+    *  Returns the free slot above the top element, linking a new chunk
+    *  (the spare one if there is one) when the top chunk is full.
+    */
+    type& slot() {
+        if (_used == chunkSize) {
+            Chunk* chunk = _spare != nullptr ? _spare : new Chunk();
+            _spare = nullptr;
+            chunk->below = _top;
+            _top = chunk;
+            _used = 0;
+        }
+        return _top->items[_used];
+    }
+
+    /**
+    *  Returns the chunks from the bottom up.
+    */
+    Vector<Chunk*> chunks() const {
+        Vector<Chunk*> list;
+        for (Chunk* chunk = _top; chunk != nullptr; chunk = chunk->below)
+            list.push_front(chunk);
+        return list;
+    }
+
+    void copy(const SegmentedStack& stack) {
+        Vector<Chunk*> list = stack.chunks();
+        for (int i = 0; i < list.size(); i++) {
+            int count = i == list.size() - 1 ? stack._used : chunkSize;
+            for (int j = 0; j < count; j++)
+                push(list[i]->items[j]);
+        }
+    }
+
+    void release() {
+        while (_top != nullptr) {
+            Chunk* trash = _top;
+            _top = _top->below;
+            delete trash;
+        }
+        delete _spare;
+    }
+
+    // member variable (fields)
+    Chunk* _top;                  // Chunk holding the top element
+    Chunk* _spare;                // Empty chunk kept for the next growth
+    int _used;                    // Elements in the top chunk
+    int _size;
+};
+
+
+template <typename type, int chunkSize>
+ostream& operator<<(ostream& out, const SegmentedStack<type, chunkSize>& stack) {
+    Vector<typename SegmentedStack<type, chunkSize>::Chunk*> list = stack.chunks();
+    out << "{ ";
+    for (int i = 0; i < list.size(); i++) {
+        int count = i == list.size() - 1 ? stack._used : chunkSize;
+        for (int j = 0; j < count; j++) {
+            if (i == list.size() - 1 && j == count - 1)
+                out << list[i]->items[j];
+            else
+                out << list[i]->items[j] << ", ";
+        }
+    }
+    out << " }";
+    return out;
+}
+
+
+#endif // _segmentedstack_h
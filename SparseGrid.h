@@ -0,0 +1,977 @@
+#ifndef _sparsegrid_h
+#define _sparsegrid_h
+
+#include <iostream>
+#include <utility>
+#include "Grid.h"
+#include "Vector.h"
+
+using namespace std;
+
+template <typename type>
+class CompressedGrid;
+
+/**
+*  It is a Grid for mostly-default data, e.g. a 100000 x 100000 matrix
+*  with a few million non-zero entries.
+*
+*  Only cells holding something other than <code>type()</code> are stored.
+*  The Grid is cut into 8 x 8 blocks, and a block exists only while one of
+*  its cells is non-default: it holds a 64 bit mask of which cells are set
+*  and just those values, packed in bit order, so a cell's place is the
+*  number of set bits below it.  Blocks are found through an
+*  open-addressing hash on their block number that stores only an index
+*  per slot.  A lone cell costs its value plus a few dozen bytes of block
+*  and hash, and a full block little more than its 64 values, so memory
+*  grows with the number of non-default cells.  <code>forEach</code>
+*  visits only those.  Setting a cell back to the default value erases
+*  it.
+*
+*  The API follows Grid.  Use <code>compress</code> to get a read-only
+*  CSR form for row scans and matrix-vector products.
+*/
+template <typename type>
+class SparseGrid {
+public:
+    class Reference;
+    class Row;
+    class ConstRow;
+
+    /**
+    *  Side of the square blocks cells are stored in.
+    */
+    static const int BLOCK = 8;
+
+    /**
+    *  Initializes a new SparseGrid.
+    */
+    SparseGrid();
+
+    /**
+    *  Initializes a new SparseGrid with given numbers row and column, all
+    *  default.  Nothing is allocated for the cells.
+    */
+    SparseGrid(int row, int column);
+
+    /**
+    *  Initializes a new SparseGrid holding the non-default cells of
+    *  <code>grid</code>.
+    */
+    explicit SparseGrid(const Grid<type>& grid);
+
+    /**
+    *  Copy Constructor - Deep Copy
+    *  Take Constructor - Sallow Copy
+    */
+    SparseGrid(const SparseGrid& grid);     ///Copy Constructor
+    SparseGrid(SparseGrid&& grid);          ///Take Constructor
+
+    /**
+    *  Frees any heap storage associated with this SparseGrid.
+    */
+    virtual ~SparseGrid() { }
+
+    /**
+    *  Sets every value in the SparseGrid to its element type's default
+    *  value, freeing every block.
+    */
+    void clear();
+
+    /**
+    *  Returns the number of non-default cells.
+    */
+    int count() const;
+
+    /**
+    *  Returns <code>true</code> if this SparseGrid contains exactly the
+    *  same values as the given other SparseGrid.
+    *  Identical in behavior to the == operator.
+    */
+    bool equals(const SparseGrid& grid) const;
+
+    /**
+    *  Stores the given value in every cell of this SparseGrid.  Filling
+    *  with anything but the default value makes every cell non-default,
+    *  so it costs as much memory as a dense Grid.
+    */
+    void fill(const type& value);
+
+    /**
+    *  Calls <code>fn(row, col, value)</code> for every non-default cell,
+    *  block by block in no particular order.
+    */
+    template <typename Fn>
+    void forEach(Fn fn) const;
+
+    /**
+    *  Returns the element at the specified <code>row</code>/<code>col</code>
+    *  position in this SparseGrid.
+    *  @throw "Exception" if the <code>row</code> and <code>col</code>
+    *  arguments are outside the SparseGrid boundaries.
+    */
+    type get(int row, int col) const;
+
+    /**
+    *  Returns the SparseGrid's height,i.e. the number of rows.
+    */
+    int height() const;
+
+    /**
+    *  Returns the SparseGrid's width,i.e. the number of columns.
+    */
+    int width() const;
+
+    /**
+    *  Returns <code>true</code> if the specified row and column position
+    *  is inside the bounds of the SparseGrid.
+    */
+    bool inBounds(int row, int col) const;
+
+    /**
+    *  Returns <code>true</code> if the SparseGrid has 0 rows and/or 0 columns.
+    */
+    bool empty() const;
+
+    /**
+    *  Calls the specified function on each element of the SparseGrid.
+    *  When <code>fn</code> maps the default value to itself only the
+    *  non-default cells are visited.
+    */
+    void map(type (*fn)(type));
+    void map(type (*fn)(type&));
+    void map(type (*fn)(const type&));
+
+    /**
+    *  Returns the number of columns in the SparseGrid.
+    */
+    int numCols() const;
+
+    /**
+    *  Returns the number of rows in the SparseGrid.
+    *  This is equal to the SparseGrid's height.
+    */
+    int numRows() const;
+
+    /**
+    *  Reinitializes the SparseGrid to have the specified number of rows
+    *  and columns.  If the <code>retain</code> parameter is true, the
+    *  cells that are still inside keep their values.
+    */
+    void resize(int row, int column, bool retain = false);
+
+    /**
+    *  Return the element at  <code>row</code>/<code>col</code>
+    *  Identical in behavior to get.
+    */
+    type at(int row, int col) const;
+
+    /**
+    *  Replaces the element at the specified <code>row</code>/<code>col</code>
+    *  location in this SparseGrid with a new value.
+    *  @throw "Exception" if the <code>row</code> and <code>col</code>
+    *  arguments are outside the SparseGrid boundaries.
+    */
+    void set(int row, int col, const type& value);
+
+    /**
+    *  Returns the total number of cells in the SparseGrid (row * col),
+    *  which may exceed the range of an int.
+    */
+    long long size() const;
+
+    /**
+    *  Returns a dense copy.
+    */
+    Grid<type> toGrid() const;
+
+    /**
+    *  Returns the read-only CSR form.
+    */
+    CompressedGrid<type> compress() const;
+
+    /// Operator Overloading
+
+    /**
+    *  Copy Assignment Operator - Deep Copy
+    *  Take Assignment Operator - Sallow Copy
+    */
+    SparseGrid& operator=(const SparseGrid& grid);  ///Copy Assignment
+    SparseGrid& operator=(SparseGrid&& grid);       ///Take Assignment
+
+    /**
+    *  Overloads <code>[]</code> so that <code>grid[row][col]</code> reads
+    *  and writes cells like a Grid.  Writes go through a small proxy.
+    *  @throw "Exception" if the arguments are outside the boundaries.
+    */
+    Row operator[](int row);
+    ConstRow operator[](int row) const;
+
+    /**
+    *  Compares two SparseGrids for equality.
+    */
+    bool operator==(const SparseGrid& grid) const;
+
+    /**
+    *  Compares two SparseGrids for inequality.
+    */
+    bool operator!=(const SparseGrid& grid) const;
+
+    /**
+    *  The proxy for one cell returned by <code>grid[row][col]</code>.
+    */
+    class Reference {
+    public:
+        Reference(SparseGrid* grid, int row, int col) : _grid(grid), _row(row), _col(col) { }
+
+        operator type() const {
+            return _grid->get(_row, _col);
+        }
+
+        Reference& operator=(const type& value) {
+            _grid->set(_row, _col, value);
+            return *this;
+        }
+
+        Reference& operator=(const Reference& other) {
+            return *this = (type)other;
+        }
+
+    private:
+        SparseGrid* _grid;
+        int _row;
+        int _col;
+    };
+
+    class Row {
+    public:
+        Row(SparseGrid* grid, int row) : _grid(grid), _row(row) { }
+
+        Reference operator[](int col) const {
+            return Reference(_grid, _row, col);
+        }
+
+    private:
+        SparseGrid* _grid;
+        int _row;
+    };
+
+    class ConstRow {
+    public:
+        ConstRow(const SparseGrid* grid, int row) : _grid(grid), _row(row) { }
+
+        type operator[](int col) const {
+            return _grid->get(_row, col);
+        }
+
+    private:
+        const SparseGrid* _grid;
+        int _row;
+    };
+
+private:
+    /**
+    *  The set cells of one block: bit <code>(row % 8) * 8 + col % 8</code>
+    *  of <code>mask</code> tells whether a cell is set, and the values of
+    *  the set cells follow each other in bit order.  A cell whose bit is
+    *  clear is <code>type()</code>.
+    */
+    struct Block {
+        long long key = -1;                 // Block row * _across + block column
+        unsigned long long mask = 0;
+        type* values = nullptr;             // One per set bit
+
+        Block() = default;
+
+        Block(const Block& block) : key(block.key), mask(block.mask) {
+            int count = countBits(mask);
+            if (count > 0) {
+                values = new type[count];
+                for (int i = 0; i < count; i++)
+                    values[i] = block.values[i];
+            }
+        }
+
+        Block(Block&& block) : key(block.key), mask(block.mask), values(block.values) {
+            block.mask = 0;
+            block.values = nullptr;
+        }
+
+        ~Block() {
+            delete[] values;
+        }
+
+        Block& operator=(const Block& block) {
+            if (this != &block) {
+                Block copy(block);
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        Block& operator=(Block&& block) {
+            std::swap(key, block.key);
+            std::swap(mask, block.mask);
+            std::swap(values, block.values);
+            return *this;
+        }
+
+        /**
+        *  Returns where the value of <code>bit</code> is, or would go.
+        */
+        int place(int bit) const {
+            return countBits(mask & ((1ull << bit) - 1));
+        }
+
+        /**
+        *  Sets <code>bit</code>, which must be clear, to <code>value</code>,
+        *  moving the values into an array one longer.
+        */
+        void insert(int bit, const type& value) {
+            int count = countBits(mask);
+            int at = place(bit);
+            type* grown = new type[count + 1];
+            for (int i = 0; i < at; i++)
+                grown[i] = std::move(values[i]);
+            grown[at] = value;
+            for (int i = at; i < count; i++)
+                grown[i + 1] = std::move(values[i]);
+            delete[] values;
+            values = grown;
+            mask |= 1ull << bit;
+        }
+
+        /**
+        *  Clears <code>bit</code>, which must be set, moving the other
+        *  values into an array one shorter.
+        */
+        void erase(int bit) {
+            int count = countBits(mask) - 1;
+            int at = place(bit);
+            type* shrunk = count > 0 ? new type[count] : nullptr;
+            for (int i = 0; i < at; i++)
+                shrunk[i] = std::move(values[i]);
+            for (int i = at; i < count; i++)
+                shrunk[i] = std::move(values[i + 1]);
+            delete[] values;
+            values = shrunk;
+            mask &= ~(1ull << bit);
+        }
+    };
+
+    long long keyOf(int row, int col) const;
+    int find(long long key) const;          // Index in _blocks, or -1
+    int findOrAdd(long long key);
+    void removeBlock(int block);
+    int home(long long key) const;          // Preferred hash slot of a key
+    void rehash(int capacity);
+    static int lowestBit(unsigned long long mask);
+    static int countBits(unsigned long long mask);
+
+    template <typename Fn>
+    void mapCells(Fn fn);
+
+    // member variable (fields)
+    int _row;                     // The number of rows in the SparseGrid
+    int _column;                  // The number of columns in the SparseGrid
+    int _across;                  // Blocks in one row of blocks
+    int _count;                   // Non-default cells
+    Vector<Block> _blocks;        // Blocks holding at least one set cell
+    Vector<int> _slots;           // Hash slots: index in _blocks, or -1
+};
+
+/**
+*  The read-only compressed sparse row (CSR) form of a SparseGrid: the
+*  non-default cells of each row sorted by column in two flat arrays, with
+*  <code>rowStart[r]</code> marking where row <code>r</code> begins.  Row
+*  scans and matrix-vector products stream through memory.
+*/
+template <typename type>
+class CompressedGrid {
+public:
+    ///  constructors
+
+    /**
+    *  Initializes an empty CompressedGrid.
+    */
+    CompressedGrid() : _row(0), _column(0), _rowStart(1, 0) { }
+
+    /**
+    *  Compresses <code>grid</code>, sorting its cells with two counting
+    *  passes, by column and then by row.
+    */
+    explicit CompressedGrid(const SparseGrid<type>& grid);
+
+    /**
+    *  Compresses the non-default cells of a dense Grid.
+    */
+    explicit CompressedGrid(const Grid<type>& grid);
+
+    ///  member function (methods)
+
+    /**
+    *  Returns the element at <code>row</code>/<code>col</code>, found by
+    *  binary search in its row.
+    *  @throw "Exception" if the position is outside the boundaries.
+    */
+    type get(int row, int col) const;
+
+    /**
+    *  Calls <code>fn(row, col, value)</code> for every non-default cell
+    *  in row-major order.
+    */
+    template <typename Fn>
+    void forEach(Fn fn) const;
+
+    /**
+    *  Calls <code>fn(col, value)</code> for the non-default cells of
+    *  <code>row</code> in column order.
+    */
+    template <typename Fn>
+    void forEachInRow(int row, Fn fn) const;
+
+    /**
+    *  Returns the product of this matrix and the column vector
+    *  <code>x</code>.
+    *  @throw "Exception" if <code>x</code> does not have numCols() entries.
+    */
+    Vector<type> multiply(const Vector<type>& x) const;
+
+    /**
+    *  Returns a dense copy.
+    */
+    Grid<type> toGrid() const;
+
+    int numRows() const { return _row; }
+    int numCols() const { return _column; }
+    int count() const { return _values.size(); }
+
+private:
+    void build(int row, int column, const Vector<int>& rows,
+               const Vector<int>& cols, const Vector<type>& values);
+
+    // member variable (fields)
+    int _row;
+    int _column;
+    Vector<int> _rowStart;        // _row + 1 offsets into _cols and _values
+    Vector<int> _cols;            // Column of each stored cell
+    Vector<type> _values;         // Value of each stored cell
+};
+
+template <typename type>
+SparseGrid<type>::SparseGrid() : SparseGrid(0, 0) { }
+
+template <typename type>
+SparseGrid<type>::SparseGrid(int row, int column)
+    : _slots(8, -1) {
+    if (row < 0 || column < 0)
+        throw "Exception :-(";
+    _row = row;
+    _column = column;
+    _across = (column + BLOCK - 1) / BLOCK;
+    _count = 0;
+}
+
+template <typename type>
+SparseGrid<type>::SparseGrid(const Grid<type>& grid) : SparseGrid(grid.numRows(), grid.numCols()) {
+    for (int r = 0; r < _row; r++)
+        for (int c = 0; c < _column; c++)
+            if (!(grid[r][c] == type()))
+                set(r, c, grid[r][c]);
+}
+
+template <typename type>
+SparseGrid<type>::SparseGrid(const SparseGrid& grid)
+    : _row(grid._row), _column(grid._column), _across(grid._across), _count(grid._count),
+      _blocks(grid._blocks), _slots(grid._slots) { }
+
+template <typename type>
+SparseGrid<type>::SparseGrid(SparseGrid&& grid) : SparseGrid(0, 0) {
+    *this = std::move(grid);
+}
+
+template <typename type>
+long long SparseGrid<type>::keyOf(int row, int col) const {
+    return (long long)(row / BLOCK) * _across + col / BLOCK;
+}
+
+template <typename type>
+int SparseGrid<type>::home(long long key) const {
+    unsigned long long hash = (unsigned long long)key * 0x9E3779B97F4A7C15ull;
+    return (int)((hash >> 32) & (unsigned)(_slots.size() - 1));
+}
+
+template <typename type>
+int SparseGrid<type>::find(long long key) const {
+    int mask = _slots.size() - 1;
+    for (int i = home(key); _slots[i] != -1; i = (i + 1) & mask)
+        if (_blocks[_slots[i]].key == key)
+            return _slots[i];
+    return -1;
+}
+
+template <typename type>
+void SparseGrid<type>::rehash(int capacity) {
+    Vector<int> slots(capacity, -1);
+    _slots.swap(slots);
+    int mask = capacity - 1;
+    for (int b = 0; b < _blocks.size(); b++) {
+        int i = home(_blocks[b].key);
+        while (_slots[i] != -1)
+            i = (i + 1) & mask;
+        _slots[i] = b;
+    }
+}
+
+template <typename type>
+int SparseGrid<type>::findOrAdd(long long key) {
+    int found = find(key);
+    if (found >= 0)
+        return found;
+
+    if (2 * (_blocks.size() + 1) > _slots.size())     /// keep the table at most half full
+        rehash(2 * _slots.size());
+    int mask = _slots.size() - 1;
+    int i = home(key);
+    while (_slots[i] != -1)
+        i = (i + 1) & mask;
+
+    Block block;
+    block.key = key;
+    _blocks.push_back(std::move(block));
+    _slots[i] = _blocks.size() - 1;
+    return _blocks.size() - 1;
+}
+
+/**
+*  Deletes a block from the hash by shifting later entries of its probe
+*  run back, so lookups never need tombstones, and fills its place in
+*  <code>_blocks</code> with the last block.
+*/
+template <typename type>
+void SparseGrid<type>::removeBlock(int block) {
+    int mask = _slots.size() - 1;
+    int hole = home(_blocks[block].key);
+    while (_slots[hole] != block)
+        hole = (hole + 1) & mask;
+
+    for (int j = (hole + 1) & mask; _slots[j] != -1; j = (j + 1) & mask) {
+        int k = home(_blocks[_slots[j]].key);
+        bool movable = hole <= j ? (k <= hole || k > j) : (k <= hole && k > j);
+        if (movable) {
+            _slots[hole] = _slots[j];
+            hole = j;
+        }
+    }
+    _slots[hole] = -1;
+
+    int last = _blocks.size() - 1;
+    if (block != last) {
+        int i = home(_blocks[last].key);
+        while (_slots[i] != last)
+            i = (i + 1) & mask;
+        _slots[i] = block;
+        _blocks[block] = std::move(_blocks[last]);
+    }
+    Block trash;
+    _blocks.pop_back(&trash, 1);
+}
+
+template <typename type>
+int SparseGrid<type>::lowestBit(unsigned long long mask) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(mask);
+#else
+    int bit = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+template <typename type>
+int SparseGrid<type>::countBits(unsigned long long mask) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(mask);
+#else
+    int count = 0;
+    for (; mask != 0; mask &= mask - 1)
+        count++;
+    return count;
+#endif
+}
+
+template <typename type>
+void SparseGrid<type>::clear() {
+    SparseGrid fresh(_row, _column);
+    *this = std::move(fresh);
+}
+
+template <typename type>
+int SparseGrid<type>::count() const {
+    return _count;
+}
+
+template <typename type>
+bool SparseGrid<type>::equals(const SparseGrid& grid) const {
+    if (_row != grid._row || _column != grid._column || _count != grid._count)
+        return false;
+    bool same = true;
+    forEach([&grid, &same](int row, int col, const type& value) {
+        if (same && !(grid.get(row, col) == value))
+            same = false;
+    });
+    return same;
+}
+
+template <typename type>
+void SparseGrid<type>::fill(const type& value) {
+    clear();
+    if (value == type())
+        return;
+    for (int r = 0; r < _row; r++)
+        for (int c = 0; c < _column; c++)
+            set(r, c, value);
+}
+
+template <typename type>
+template <typename Fn>
+void SparseGrid<type>::forEach(Fn fn) const {
+    for (int b = 0; b < _blocks.size(); b++) {
+        const Block& block = _blocks[b];
+        int row0 = (int)(block.key / _across) * BLOCK;
+        int col0 = (int)(block.key % _across) * BLOCK;
+        const type* value = block.values;
+        for (unsigned long long mask = block.mask; mask != 0; mask &= mask - 1) {
+            int bit = lowestBit(mask);
+            fn(row0 + bit / BLOCK, col0 + bit % BLOCK, *value++);
+        }
+    }
+}
+
+template <typename type>
+type SparseGrid<type>::get(int row, int col) const {
+    if (!inBounds(row, col))
+        throw "Exception :-(";
+    int block = find(keyOf(row, col));
+    int bit = (row % BLOCK) * BLOCK + col % BLOCK;
+    if (block < 0 || (_blocks[block].mask & (1ull << bit)) == 0)
+        return type();
+    return _blocks[block].values[_blocks[block].place(bit)];
+}
+
+template <typename type>
+int SparseGrid<type>::height() const {
+    return _row;
+}
+
+template <typename type>
+int SparseGrid<type>::width() const {
+    return _column;
+}
+
+template <typename type>
+bool SparseGrid<type>::inBounds(int row, int col) const {
+    return row >= 0 && col >= 0 && row < _row && col < _column;
+}
+
+template <typename type>
+bool SparseGrid<type>::empty() const {
+    return _row == 0 || _column == 0;
+}
+
+/**
+*  Applies <code>fn</code> to every cell: only to the stored ones when it
+*  keeps default cells default, otherwise to all of them.
+*/
+template <typename type>
+template <typename Fn>
+void SparseGrid<type>::mapCells(Fn fn) {
+    type background = fn(type());
+    if (!(background == type())) {
+        SparseGrid result(_row, _column);
+        for (int r = 0; r < _row; r++)
+            for (int c = 0; c < _column; c++)
+                result.set(r, c, fn(get(r, c)));
+        *this = std::move(result);
+        return;
+    }
+
+    Vector<long long> cells;                  /// positions first: set may move blocks
+    forEach([&cells, this](int row, int col, const type&) {
+        cells.push_back((long long)row * _column + col);
+    });
+    for (int i = 0; i < cells.size(); i++) {
+        int row = (int)(cells[i] / _column);
+        int col = (int)(cells[i] % _column);
+        set(row, col, fn(get(row, col)));
+    }
+}
+
+template <typename type>
+void SparseGrid<type>::map(type (*fn)(type)) {
+    mapCells([fn](type value) { return fn(value); });
+}
+
+template <typename type>
+void SparseGrid<type>::map(type (*fn)(type&)) {
+    mapCells([fn](type value) { return fn(value); });
+}
+
+template <typename type>
+void SparseGrid<type>::map(type (*fn)(const type&)) {
+    mapCells([fn](type value) { return fn(value); });
+}
+
+template <typename type>
+int SparseGrid<type>::numCols() const {
+    return _column;
+}
+
+template <typename type>
+int SparseGrid<type>::numRows() const {
+    return _row;
+}
+
+template <typename type>
+void SparseGrid<type>::resize(int row, int column, bool retain) {
+    SparseGrid result(row, column);
+    if (retain) {
+        forEach([&result](int r, int c, const type& value) {
+            if (result.inBounds(r, c))
+                result.set(r, c, value);
+        });
+    }
+    *this = std::move(result);
+}
+
+template <typename type>
+type SparseGrid<type>::at(int row, int col) const {
+    return get(row, col);
+}
+
+template <typename type>
+void SparseGrid<type>::set(int row, int col, const type& value) {
+    if (!inBounds(row, col))
+        throw "Exception :-(";
+    int bit = (row % BLOCK) * BLOCK + col % BLOCK;
+    unsigned long long flag = 1ull << bit;
+
+    if (value == type()) {                    /// erase, dropping the block once it is empty
+        int block = find(keyOf(row, col));
+        if (block < 0 || (_blocks[block].mask & flag) == 0)
+            return;
+        _count--;
+        if (_blocks[block].mask == flag)
+            removeBlock(block);
+        else
+            _blocks[block].erase(bit);
+        return;
+    }
+
+    Block& block = _blocks[findOrAdd(keyOf(row, col))];
+    if ((block.mask & flag) == 0) {
+        block.insert(bit, value);
+        _count++;
+    } else {
+        block.values[block.place(bit)] = value;
+    }
+}
+
+template <typename type>
+long long SparseGrid<type>::size() const {
+    return (long long)_row * _column;
+}
+
+template <typename type>
+Grid<type> SparseGrid<type>::toGrid() const {
+    Grid<type> grid(_row, _column);
+    forEach([&grid](int row, int col, const type& value) {
+        grid[row][col] = value;
+    });
+    return grid;
+}
+
+template <typename type>
+CompressedGrid<type> SparseGrid<type>::compress() const {
+    return CompressedGrid<type>(*this);
+}
+
+template <typename type>
+SparseGrid<type>& SparseGrid<type>::operator=(const SparseGrid& grid) {
+    if (this != &grid) {
+        SparseGrid copy(grid);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template <typename type>
+SparseGrid<type>& SparseGrid<type>::operator=(SparseGrid&& grid) {
+    if (this != &grid) {
+        std::swap(_row, grid._row);
+        std::swap(_column, grid._column);
+        std::swap(_across, grid._across);
+        std::swap(_count, grid._count);
+        _blocks.swap(grid._blocks);
+        _slots.swap(grid._slots);
+    }
+    return *this;
+}
+
+template <typename type>
+typename SparseGrid<type>::Row SparseGrid<type>::operator[](int row) {
+    if (row < 0 || !(row < _row))
+        throw "Exception :-(";
+    return Row(this, row);
+}
+
+template <typename type>
+typename SparseGrid<type>::ConstRow SparseGrid<type>::operator[](int row) const {
+    if (row < 0 || !(row < _row))
+        throw "Exception :-(";
+    return ConstRow(this, row);
+}
+
+template <typename type>
+bool SparseGrid<type>::operator==(const SparseGrid& grid) const {
+    return equals(grid);
+}
+
+template <typename type>
+bool SparseGrid<type>::operator!=(const SparseGrid& grid) const {
+    return !equals(grid);
+}
+
+template <typename type>
+CompressedGrid<type>::CompressedGrid(const SparseGrid<type>& grid) {
+    Vector<int> rows;
+    Vector<int> cols;
+    Vector<type> values;
+    rows.reserve(grid.count());
+    cols.reserve(grid.count());
+    values.reserve(grid.count());
+    grid.forEach([&rows, &cols, &values](int row, int col, const type& value) {
+        rows.push_back(row);
+        cols.push_back(col);
+        values.push_back(value);
+    });
+    build(grid.numRows(), grid.numCols(), rows, cols, values);
+}
+
+template <typename type>
+CompressedGrid<type>::CompressedGrid(const Grid<type>& grid) {
+    Vector<int> rows;
+    Vector<int> cols;
+    Vector<type> values;
+    for (int r = 0; r < grid.numRows(); r++) {
+        for (int c = 0; c < grid.numCols(); c++) {
+            if (!(grid[r][c] == type())) {
+                rows.push_back(r);
+                cols.push_back(c);
+                values.push_back(grid[r][c]);
+            }
+        }
+    }
+    build(grid.numRows(), grid.numCols(), rows, cols, values);
+}
+
+/**
+*  Lays out cells given in any order: a stable counting pass by column,
+*  then one by row, leaves every row sorted by column.
+*/
+template <typename type>
+void CompressedGrid<type>::build(int row, int column, const Vector<int>& rows,
+                                 const Vector<int>& cols, const Vector<type>& values) {
+    _row = row;
+    _column = column;
+    int n = values.size();
+
+    Vector<int> colStart(column + 1, 0);
+    for (int i = 0; i < n; i++)
+        colStart[cols[i] + 1]++;
+    for (int c = 0; c < column; c++)
+        colStart[c + 1] += colStart[c];
+    Vector<int> byCol(n);
+    for (int i = 0; i < n; i++)
+        byCol[colStart[cols[i]]++] = i;
+
+    Vector<int> rowStart(row + 1, 0);
+    for (int i = 0; i < n; i++)
+        rowStart[rows[i] + 1]++;
+    for (int r = 0; r < row; r++)
+        rowStart[r + 1] += rowStart[r];
+
+    Vector<int> next(rowStart);
+    Vector<int> sortedCols(n);
+    Vector<type> sortedValues(n);
+    for (int k = 0; k < n; k++) {
+        int i = byCol[k];
+        int at = next[rows[i]]++;
+        sortedCols[at] = cols[i];
+        sortedValues[at] = values[i];
+    }
+    _rowStart.swap(rowStart);
+    _cols.swap(sortedCols);
+    _values.swap(sortedValues);
+}
+
+template <typename type>
+type CompressedGrid<type>::get(int row, int col) const {
+    if (row < 0 || col < 0 || row >= _row || col >= _column)
+        throw "Exception :-(";
+    int low = _rowStart[row];
+    int high = _rowStart[row + 1];
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (_cols[mid] < col)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low < _rowStart[row + 1] && _cols[low] == col ? _values[low] : type();
+}
+
+template <typename type>
+template <typename Fn>
+void CompressedGrid<type>::forEach(Fn fn) const {
+    for (int r = 0; r < _row; r++)
+        for (int i = _rowStart[r]; i < _rowStart[r + 1]; i++)
+            fn(r, _cols[i], _values[i]);
+}
+
+template <typename type>
+template <typename Fn>
+void CompressedGrid<type>::forEachInRow(int row, Fn fn) const {
+    if (row < 0 || row >= _row)
+        throw "Exception :-(";
+    for (int i = _rowStart[row]; i < _rowStart[row + 1]; i++)
+        fn(_cols[i], _values[i]);
+}
+
+template <typename type>
+Vector<type> CompressedGrid<type>::multiply(const Vector<type>& x) const {
+    if (x.size() != _column)
+        throw "Exception :-(";
+    Vector<type> y(_row);
+    for (int r = 0; r < _row; r++) {
+        type sum = type();
+        for (int i = _rowStart[r]; i < _rowStart[r + 1]; i++)
+            sum += _values[i] * x[_cols[i]];
+        y[r] = sum;
+    }
+    return y;
+}
+
+template <typename type>
+Grid<type> CompressedGrid<type>::toGrid() const {
+    Grid<type> grid(_row, _column);
+    forEach([&grid](int row, int col, const type& value) {
+        grid[row][col] = value;
+    });
+    return grid;
+}
+
+
+#endif // _sparsegrid_h
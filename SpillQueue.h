@@ -0,0 +1,288 @@
+#ifndef _spillqueue_h
+#define _spillqueue_h
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <future>
+#include <type_traits>
+#include "Vector.h"
+#include "LinkedList.h"
+
+using namespace std;
+
+/**
+*  Writes <code>value</code> to a spill segment as raw bytes.  Overload
+*  spillWrite/spillRead for any type that is not trivially copyable.
+*/
+template <typename type>
+void spillWrite(ostream& out, const type& value) {
+    static_assert(is_trivially_copyable<type>::value,
+                  "overload spillWrite and spillRead for this type");
+    out.write(reinterpret_cast<const char*>(&value), sizeof(type));
+}
+
+template <typename type>
+void spillRead(istream& in, type& value) {
+    static_assert(is_trivially_copyable<type>::value,
+                  "overload spillWrite and spillRead for this type");
+    in.read(reinterpret_cast<char*>(&value), sizeof(type));
+}
+
+/**
+*  Strings are written as their length followed by their characters.
+*/
+inline void spillWrite(ostream& out, const string& value) {
+    int length = value.size();
+    out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    out.write(value.data(), length);
+}
+
+inline void spillRead(istream& in, string& value) {
+    int length = 0;
+    in.read(reinterpret_cast<char*>(&length), sizeof(length));
+    value.resize(length);
+    in.read(&value[0], length);
+}
+
+/**
+ * This class models a first-in/first-out queue that can grow beyond
+ * memory.  The oldest values sit in an in-memory head and the newest in
+ * an in-memory tail, each holding at most <code>limit</code> values.
+ * When the tail fills up it is written out, in one sequential pass, as an
+ * append-only segment file.  The oldest segment on disk is read ahead on
+ * a background thread, so when the head runs dry it is usually already
+ * in memory and is swapped in before its file is deleted.  Both ends
+ * therefore run at memory speed and the disk only ever sees large
+ * sequential reads and writes.  At most one segment is in memory besides
+ * the head and the tail.
+ *
+ * Values are written with <code>spillWrite</code> and read back with
+ * <code>spillRead</code>, which runs on the read-ahead thread.
+ */
+template <typename type>
+class SpillQueue {
+public:
+    ///  constructors and destructor
+
+    /**
+    *  Initializes a new empty queue that keeps up to <code>limit</code>
+    *  values in memory at each end and writes its segment files into
+    *  <code>directory</code>.
+    *  @throw "Exception" if <code>limit</code> is less then 1
+    */
+    SpillQueue(const string& directory, int limit = 65536) {
+        if (limit < 1)
+            throw "Exception :-(";
+        _directory = directory;
+        _limit = limit;
+        _headPos = 0;
+        _spilled = 0;
+        _nextSegment = 0;
+        _head.reserve(limit);
+        _tail.reserve(limit);
+    }
+
+    /**
+    *  A queue owns its segment files, so it can not be copied.
+    */
+    SpillQueue(const SpillQueue& queue) = delete;
+    SpillQueue& operator=(const SpillQueue& queue) = delete;
+
+    /**
+    *  Deletes every segment file that is still on disk.
+    */
+    virtual ~SpillQueue() {
+        clear();
+    }
+
+    ///  member function (methods)
+
+    /**
+    *  Adds <code>value</code> to the end of the queue.
+    *  @throw "Exception" if a full tail can not be written to disk
+    */
+    void enqueue(const type& value) {
+        if (_spilled == 0 && _tail.empty() && _head.size() < _limit) {
+            _head.push_back(value);
+            return;
+        }
+        _tail.push_back(value);
+        if (_tail.size() >= _limit)
+            spill();
+    }
+
+    /**
+    *  Removes and returns the first value in the queue.
+    *  @throw "Exception" for empty queue
+    */
+    type dequeue() {
+        if (!refill())
+            throw "Exception :-(";
+        type value = std::move(_head[_headPos++]);
+        return value;
+    }
+
+    /**
+    *  Returns the first value in the queue, without removing it.  This may
+    *  read a segment back from disk.
+    *  @throw "Exception" for empty queue
+    */
+    const type& front() {
+        if (!refill())
+            throw "Exception :-(";
+        return _head[_headPos];
+    }
+
+    /**
+    *  Removes all values and deletes every segment file.
+    */
+    void clear() {
+        if (_ahead.valid())
+            _ahead.wait();                  /// it may still be reading a file
+        _ahead = future<Vector<type>>();
+        while (!_segments.empty()) {
+            std::remove(_segments.front().path.c_str());
+            _segments.pop_front();
+        }
+        _head.clear();
+        _tail.clear();
+        _headPos = 0;
+        _spilled = 0;
+    }
+
+    /**
+    *  Returns <code>true</code> if the queue contains no values.
+    */
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+    *  Returns the number of values in the queue, in memory and on disk.
+    */
+    long long size() const {
+        return (long long)(_head.size() - _headPos) + _spilled + _tail.size();
+    }
+
+    /**
+    *  Returns the number of values currently written out to disk.
+    */
+    long long spilled() const {
+        return _spilled;
+    }
+
+private:
+    /**
+    *  One segment file and the number of values in it.
+    */
+    struct Segment {
+        string path;
+        int count = 0;
+    };
+
+    /**
+    *  Writes the whole tail to a new segment file and empties it.
+    */
+    void spill() {
+        Segment segment;
+        segment.path = _directory + "/spill-" + to_string((long long)this)
+                     + "-" + to_string(_nextSegment++) + ".seg";
+        segment.count = _tail.size();
+
+        ofstream out(segment.path, ios::binary | ios::trunc);
+        if (!out)
+            throw "Exception :-(";
+        for (int i = 0; i < segment.count; i++)
+            spillWrite(out, _tail[i]);
+        out.close();
+        if (!out) {
+            std::remove(segment.path.c_str());
+            throw "Exception :-(";
+        }
+
+        _segments.push_back(segment);
+        _spilled += segment.count;
+        _tail.clear();
+        _tail.reserve(_limit);
+        readAhead();
+    }
+
+    /**
+    *  Reads all <code>count</code> values of the segment file at
+    *  <code>path</code>.
+    *  @throw "Exception" if the file can not be read
+    */
+    static Vector<type> readSegment(const string& path, int count) {
+        ifstream in(path, ios::binary);
+        if (!in)
+            throw "Exception :-(";
+        Vector<type> values;
+        values.reserve(count);
+        type value;
+        for (int i = 0; i < count; i++) {
+            spillRead(in, value);
+            values.push_back(value);
+        }
+        if (!in)
+            throw "Exception :-(";
+        return values;
+    }
+
+    /**
+    *  Starts reading the oldest segment on a background thread, unless a
+    *  read is already under way or nothing is on disk.
+    */
+    void readAhead() {
+        if (_ahead.valid() || _segments.empty())
+            return;
+        Segment segment = _segments.front();
+        _ahead = async(launch::async, [segment]() {
+            return readSegment(segment.path, segment.count);
+        });
+    }
+
+    /**
+    *  Makes sure the head holds at least one value, taking over the oldest
+    *  segment or the tail.  The segment stays queued and on disk until it
+    *  has been read in full, so a failed read loses nothing and can be
+    *  retried.  Returns <code>false</code> if the queue is empty.
+    *  @throw "Exception" if the oldest segment can not be read
+    */
+    bool refill() {
+        if (_headPos < _head.size())
+            return true;
+
+        if (!_segments.empty()) {
+            Segment segment = _segments.front();
+            Vector<type> values = _ahead.valid() ? _ahead.get()
+                                                 : readSegment(segment.path, segment.count);
+            _head.swap(values);
+            _headPos = 0;
+            _segments.pop_front();
+            std::remove(segment.path.c_str());
+            _spilled -= segment.count;
+            readAhead();
+        } else {
+            _head.clear();
+            _headPos = 0;
+            _head.swap(_tail);
+        }
+        return _headPos < _head.size();
+    }
+
+    // member variable (fields)
+    Vector<type> _head;           // Oldest values, consumed from _headPos
+    Vector<type> _tail;           // Newest values, not yet spilled
+    LinkedList<Segment> _segments; // Segment files from oldest to newest
+    future<Vector<type>> _ahead;  // Reading _segments.front(), if valid
+    string _directory;
+    int _limit;                   // Values kept in memory at each end
+    int _headPos;
+    long long _spilled;           // Values currently on disk
+    int _nextSegment;
+};
+
+
+#endif // _spillqueue_h
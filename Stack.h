@@ -5,6 +5,7 @@
 #include "Vector.h"
 #include <iostream>
 #include <initializer_list>
+#include <utility>
 
 using namespace std;
 
@@ -16,7 +17,7 @@ using namespace std;
  * operations are <code>push</code> (add to top) and <code>pop</code>
  * (remove from top).
  */
-template <typename type>
+template <typename type, typename Alloc = HeapAllocator<type> >
 class Stack {
 public:
     ///  constructors and destructor
@@ -27,17 +28,19 @@ public:
     */
     Stack() = default;
 
+    /**
+    *  Initializes a new empty stack that takes its storage from
+    *  <code>alloc</code>, e.g. an <code>ArenaAllocator</code>.
+    */
+    Stack(const Alloc& alloc) : _elements(alloc) { }
+
     /**
     *  Copy Constructor - use the passed Stack to initialization itself (deep copy)
     *  Take Constructor - use the passed Stack to initialization itself (shallow copy)
     */
-    Stack(const Stack& stack) {    ///Copy Constructor
-        _elements = stack._elements;
-    }
+    Stack(const Stack& stack) : _elements(stack._elements) { }    ///Copy Constructor
 
-    Stack(Stack&& stack) {        ///Take Constructor
-        _elements = stack._elements;
-    }
+    Stack(Stack&& stack) : _elements(std::move(stack._elements)) { }    ///Take Constructor
 
     /**
     *  Create a stack using initializer list
@@ -58,6 +61,47 @@ public:
         _elements.push_back(value);
     }
 
+    void push(type&& value) {
+        _elements.push_back(std::move(value));
+    }
+
+    /**
+    *  Builds a new value from <code>args</code> on the top of this stack.
+    */
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        _elements.emplace_back(std::forward<Args>(args)...);
+    }
+
+    /**
+    *  Pushes <code>count</code> values from <code>values</code> onto this
+    *  stack in order, so <code>values[count - 1]</code> ends on top.
+    *  The storage grows at most once for the whole block.
+    *  @throw "Exception" if <code>count</code> is less then 0
+    */
+    void push_range(const type* values, int count) {
+        _elements.push_back(values, count);
+    }
+
+    void push_range(const Vector<type>& values) {
+        if (!values.empty())
+            _elements.push_back(&values[0], values.size());
+    }
+
+    /**
+    *  Removes the top <code>count</code> elements from this stack and
+    *  returns them in the order pop would, i.e. the old top first.
+    *  @throw "Exception" if the stack has fewer than <code>count</code> elements
+    */
+    Vector<type> pop_n(int count) {
+        if (count < 0 || count > size())
+            throw "Exception :-(";
+        Vector<type> values(count);
+        if (count > 0)
+            _elements.pop_back(&values[0], count);
+        return values;
+    }
+
     /**
     *  Removes all elements from this stack.
     */
@@ -70,7 +114,7 @@ public:
     *  as the given other stack.
     *  Identical in behavior to the == operator.
     */
-    bool equals(const Stack<type>& stack) const  {
+    bool equals(const Stack& stack) const  {
         return _elements.equals(stack._elements);
     }
 
@@ -99,8 +143,8 @@ public:
     type pop() {
         if (empty())
             throw "Exception :-(";
-        type element = _elements[_elements.size() - 1];
-        _elements.pop_back();
+        type element;
+        _elements.pop_back(&element, 1);    /// moves it out, never shrinks
         return element;
     }
 
@@ -109,7 +153,7 @@ public:
     *  A synonym for the pop method.
     */
     type remove() {
-        pop();
+        return pop();
     }
 
 
@@ -159,7 +203,7 @@ public:
 
     Stack& operator=(Stack&& stack) {    ///Take assignment operator
         if (this != &stack)
-            _elements = stack._elements;
+            _elements.swap(stack._elements);
         return *this;
     }
 
@@ -208,8 +252,7 @@ public:
     *  A synonym for the push method. But you can use as an operator.
     */
     Stack operator+(const type& value) {
-        Stack<type> stack;
-        stack._elements.addAll(_elements);
+        Stack stack(*this);
         stack.push(value);
         return stack;
     }
@@ -226,28 +269,28 @@ public:
     *  Vector class.
     */
 
-    template <typename T>
-    friend ostream& operator<<(ostream& out, Stack<T>& stack);
+    template <typename T, typename A>
+    friend ostream& operator<<(ostream& out, Stack<T, A>& stack);
 
-    template <typename T>
-    friend ostream& operator<<(ostream& out, const Stack<T>& stack);
+    template <typename T, typename A>
+    friend ostream& operator<<(ostream& out, const Stack<T, A>& stack);
 
 private:
     // member variable (fields)
-    Vector<type> _elements;
+    Vector<type, Alloc> _elements;
 };
 
 
 
 
-template <typename type>
-ostream& operator<<(ostream& out, Stack<type>& stack) {
+template <typename type, typename Alloc>
+ostream& operator<<(ostream& out, Stack<type, Alloc>& stack) {
     out << stack._elements;
     return out;
 }
 
-template <typename type>
-ostream& operator<<(ostream& out, const Stack<type>& stack) {
+template <typename type, typename Alloc>
+ostream& operator<<(ostream& out, const Stack<type, Alloc>& stack) {
     out << stack._elements;
     return out;
 }
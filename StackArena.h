@@ -0,0 +1,216 @@
+#ifndef _stackarena_h
+#define _stackarena_h
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+using namespace std;
+
+/**
+ * This class models a monotonic arena: raw memory handed out by bumping a
+ * pointer through large chunks.  Memory is never given back one block at
+ * a time.  Instead the arena is used like a stack: <code>mark</code>
+ * remembers the current top, <code>rewind</code> drops everything
+ * allocated since, and <code>reset</code> drops everything.  Both run in
+ * O(1) and keep the chunks for reuse, so a per-request arena stops
+ * allocating once it has seen its largest request.
+ *
+ * The arena does not run destructors.  Objects placed in it must be
+ * destroyed by their owner first, which <code>ArenaAllocator</code> does
+ * for the containers.
+ */
+class StackArena {
+public:
+    /**
+    *  A position in the arena returned by <code>mark</code>.
+    */
+    struct Mark {
+        void* chunk;
+        size_t used;
+    };
+
+    ///  constructors and destructor
+
+    /**
+    *  Initializes a new arena whose chunks hold <code>chunkSize</code>
+    *  bytes.  Bigger requests get a chunk of their own.
+    *  @throw "Exception" if <code>chunkSize</code> is 0
+    */
+    StackArena(size_t chunkSize = 64 * 1024) {
+        if (chunkSize == 0)
+            throw "Exception :-(";
+        _chunkSize = chunkSize;
+        _first = newChunk(chunkSize);
+        _current = _first;
+    }
+
+    /**
+    *  Memory handed out points into the arena, so it can not be copied.
+    */
+    StackArena(const StackArena& arena) = delete;
+    StackArena& operator=(const StackArena& arena) = delete;
+
+    /**
+    *  Frees every chunk.
+    */
+    virtual ~StackArena() {
+        while (_first != nullptr) {
+            Chunk* trash = _first;
+            _first = _first->next;
+            ::operator delete(trash);
+        }
+    }
+
+    ///  member function (methods)
+
+    /**
+    *  Returns <code>size</code> bytes aligned to <code>alignment</code>,
+    *  which must be a power of two.
+    *  @throw "Exception" if <code>alignment</code> is not a power of two
+    */
+    void* allocate(size_t size, size_t alignment = alignof(max_align_t)) {
+        if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+            throw "Exception :-(";
+
+        void* block = bump(_current, size, alignment);
+        while (block == nullptr) {
+            Chunk* next = _current->next;
+            if (next == nullptr || next->size < size + alignment) {
+                size_t bytes = size + alignment > _chunkSize ? size + alignment : _chunkSize;
+                Chunk* fresh = newChunk(bytes);       /// link it in after the current one
+                fresh->next = next;
+                _current->next = fresh;
+                next = fresh;
+            }
+            _current = next;
+            _current->used = 0;
+            block = bump(_current, size, alignment);
+        }
+        return block;
+    }
+
+    /**
+    *  Returns the current top of the arena.
+    */
+    Mark mark() const {
+        Mark mark;
+        mark.chunk = _current;
+        mark.used = _current->used;
+        return mark;
+    }
+
+    /**
+    *  Frees everything allocated since <code>mark</code> was taken.  Marks
+    *  taken after it become invalid.
+    */
+    void rewind(const Mark& mark) {
+        _current = static_cast<Chunk*>(mark.chunk);
+        _current->used = mark.used;
+    }
+
+    /**
+    *  Frees everything allocated from the arena, keeping its chunks.
+    */
+    void reset() {
+        _current = _first;
+        _current->used = 0;
+    }
+
+    /**
+    *  Returns the number of bytes reserved from the system in chunks.
+    */
+    size_t capacity() const {
+        size_t total = 0;
+        for (Chunk* chunk = _first; chunk != nullptr; chunk = chunk->next)
+            total += chunk->size;
+        return total;
+    }
+
+private:
+    /**
+    *  A chunk header; its <code>size</code> bytes follow it directly.
+    *  Chunks after <code>_current</code> are free, and their
+    *  <code>used</code> count is reset when the arena moves into them.
+    */
+    struct Chunk {
+        Chunk* next;
+        size_t size;
+        size_t used;
+
+        char* data() {
+            return reinterpret_cast<char*>(this + 1);
+        }
+    };
+
+    static Chunk* newChunk(size_t size) {
+        Chunk* chunk = static_cast<Chunk*>(::operator new(sizeof(Chunk) + size));
+        chunk->next = nullptr;
+        chunk->size = size;
+        chunk->used = 0;
+        return chunk;
+    }
+
+    /**
+    *  Carves an aligned block out of <code>chunk</code>, or returns
+    *  <code>nullptr</code> if it does not fit.
+    */
+    static void* bump(Chunk* chunk, size_t size, size_t alignment) {
+        uintptr_t base = reinterpret_cast<uintptr_t>(chunk->data());
+        uintptr_t start = (base + chunk->used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        if (start + size > base + chunk->size)
+            return nullptr;
+        chunk->used = start + size - base;
+        return reinterpret_cast<void*>(start);
+    }
+
+    // member variable (fields)
+    Chunk* _first;
+    Chunk* _current;              // Chunk being bumped through
+    size_t _chunkSize;
+};
+
+/**
+ * An allocator that lets the containers draw their storage from a
+ * <code>StackArena</code>, e.g.
+ * <code>Stack&lt;int, ArenaAllocator&lt;int&gt; &gt; stack(ArenaAllocator&lt;int&gt;(arena));</code>
+ * Blocks handed back are only destroyed; their memory is reclaimed when
+ * the arena is rewound or reset, which must not happen while a container
+ * still uses it.
+ */
+template <typename type>
+class ArenaAllocator {
+public:
+    template <typename otherType>
+    struct rebind {
+        typedef ArenaAllocator<otherType> other;
+    };
+
+    ArenaAllocator(StackArena& arena) : _arena(&arena) { }
+
+    template <typename otherType>
+    ArenaAllocator(const ArenaAllocator<otherType>& alloc) : _arena(alloc._arena) { }
+
+    type* allocate(int count) {
+        type* block = static_cast<type*>(_arena->allocate(sizeof(type) * count, alignof(type)));
+        for (int i = 0; i < count; i++)
+            new (&block[i]) type();
+        return block;
+    }
+
+    void deallocate(type* block, int count) {
+        if (block == nullptr)
+            return;
+        for (int i = 0; i < count; i++)
+            block[i].~type();
+    }
+
+private:
+    template <typename otherType>
+    friend class ArenaAllocator;
+
+    StackArena* _arena;
+};
+
+
+#endif // _stackarena_h
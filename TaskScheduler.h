@@ -0,0 +1,255 @@
+#ifndef _taskscheduler_h
+#define _taskscheduler_h
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include "Vector.h"
+#include "WorkStealingDeque.h"
+
+using namespace std;
+
+/**
+ * This class runs fork-join work on a fixed pool of threads.  Every
+ * worker owns a <code>WorkStealingDeque</code>: tasks forked by a worker
+ * go to the bottom of its own deque, and idle workers steal the oldest
+ * tasks from the others, so the load balances itself across all cores.
+ * Tasks forked from outside the pool go through a shared injection deque.
+ *
+ * A thread that waits for its forked tasks keeps running tasks while it
+ * waits, so nested <code>parallel_for</code> and <code>invoke</code>
+ * calls never dead-lock the pool.  Tasks must not throw.
+ */
+class TaskScheduler {
+public:
+    ///  constructors and destructor
+
+    /**
+    *  Starts a pool of <code>threads</code> workers.  If
+    *  <code>threads</code> is 0 or less one worker per core is started.
+    */
+    TaskScheduler(int threads = 0) {
+        if (threads <= 0)
+            threads = (int)thread::hardware_concurrency();
+        if (threads <= 0)
+            threads = 1;
+
+        _running.store(true);
+        for (int i = 0; i < threads; i++)
+            _deques.push_back(new WorkStealingDeque<Task*>());
+        for (int i = 0; i < threads; i++)
+            _workers.push_back(new thread(&TaskScheduler::work, this, i));
+    }
+
+    TaskScheduler(const TaskScheduler& scheduler) = delete;
+    TaskScheduler& operator=(const TaskScheduler& scheduler) = delete;
+
+    /**
+    *  Stops and joins every worker.  Work still queued is not run but
+    *  freed, so callers must wait for their tasks first.
+    */
+    virtual ~TaskScheduler() {
+        {
+            lock_guard<mutex> lock(_sleepLock);
+            _running.store(false);
+        }
+        _sleep.notify_all();
+        for (int i = 0; i < _workers.size(); i++) {
+            _workers[i]->join();
+            delete _workers[i];
+        }
+        Task* task = nullptr;
+        for (int i = 0; i < _deques.size(); i++) {
+            while (_deques[i]->pop(task))
+                delete task;
+            delete _deques[i];
+        }
+        while (_injected.steal(task))
+            delete task;
+    }
+
+    ///  member function (methods)
+
+    /**
+    *  Returns a scheduler with one worker per core shared by the whole
+    *  program.  It is started on first use.
+    */
+    static TaskScheduler& instance() {
+        static TaskScheduler scheduler;
+        return scheduler;
+    }
+
+    /**
+    *  Returns the number of worker threads in the pool.
+    */
+    int threads() const {
+        return _deques.size();
+    }
+
+    /**
+    *  Calls <code>fn(i)</code> for every <code>i</code> from
+    *  <code>begin</code> up to <code>end</code>.  The range is split in
+    *  halves until a piece has at most <code>grain</code> indices, and the
+    *  call returns once every piece has run.
+    */
+    template <typename Fn>
+    void parallel_for(int begin, int end, Fn fn, int grain = 1) {
+        if (end <= begin)
+            return;
+        if (grain < 1)
+            grain = 1;
+        atomic<int> pending(1);
+        split(begin, end, grain, fn, pending);
+        wait(pending);
+    }
+
+    /**
+    *  Runs <code>left</code> and <code>right</code> in parallel and
+    *  returns once both have finished.  This is the fork-join building
+    *  block for divide and conquer algorithms such as a parallel sort.
+    */
+    template <typename Left, typename Right>
+    void invoke(Left left, Right right) {
+        atomic<int> pending(1);
+        fork([&right, &pending]() {
+            right();
+            pending.fetch_sub(1, memory_order_release);
+        });
+        left();
+        wait(pending);
+    }
+
+private:
+    /**
+    *  A unit of forked work.  It is owned by whoever runs it.
+    */
+    struct Task {
+        function<void()> fn;
+
+        Task(function<void()> f) : fn(f) { }
+    };
+
+    /**
+    *  Runs <code>fn</code> on the indices <code>[begin, end)</code>,
+    *  forking the upper half while the range is bigger than the grain.
+    */
+    template <typename Fn>
+    void split(int begin, int end, int grain, Fn& fn, atomic<int>& pending) {
+        while (end - begin > grain) {
+            int mid = begin + (end - begin) / 2;
+            int last = end;
+            pending.fetch_add(1, memory_order_relaxed);
+            fork([this, mid, last, grain, &fn, &pending]() {
+                split(mid, last, grain, fn, pending);
+            });
+            end = mid;
+        }
+        for (int i = begin; i < end; i++)
+            fn(i);
+        pending.fetch_sub(1, memory_order_release);
+    }
+
+    /**
+    *  Queues a task on the calling worker's deque, or on the injection
+    *  deque when the caller is not one of this pool's workers.  Outside
+    *  threads take turns as the injection deque's owner under
+    *  <code>_injectLock</code>; workers take from it by stealing, oldest
+    *  first.
+    */
+    void fork(function<void()> fn) {
+        Task* task = new Task(fn);
+        if (_current == this) {
+            _deques[_index]->push(task);
+        } else {
+            lock_guard<mutex> lock(_injectLock);
+            _injected.push(task);
+        }
+        if (_idle.load(memory_order_relaxed) > 0)
+            _sleep.notify_one();
+    }
+
+    /**
+    *  Finds one task to run: first from the caller's own deque, then from
+    *  the injection deque, then by stealing from the other workers.
+    */
+    Task* find(int index) {
+        Task* task = nullptr;
+        if (index >= 0 && _deques[index]->pop(task))
+            return task;
+
+        if (_injected.steal(task))
+            return task;
+
+        int count = _deques.size();
+        int start = index >= 0 ? index + 1 : 0;
+        for (int i = 0; i < count; i++) {
+            int victim = (start + i) % count;
+            if (victim != index && _deques[victim]->steal(task))
+                return task;
+        }
+        return nullptr;
+    }
+
+    /**
+    *  Runs other tasks until every task counted by <code>pending</code>
+    *  has finished.
+    */
+    void wait(atomic<int>& pending) {
+        int index = _current == this ? _index : -1;
+        while (pending.load(memory_order_acquire) > 0) {
+            Task* task = find(index);
+            if (task != nullptr) {
+                task->fn();
+                delete task;
+            } else {
+                this_thread::yield();
+            }
+        }
+    }
+
+    /**
+    *  The loop of worker <code>index</code>: run tasks while there are
+    *  any, spin briefly when there are none, then sleep until woken.
+    */
+    void work(int index) {
+        _current = this;
+        _index = index;
+        int misses = 0;
+        while (_running.load(memory_order_relaxed)) {
+            Task* task = find(index);
+            if (task != nullptr) {
+                task->fn();
+                delete task;
+                misses = 0;
+            } else if (++misses < 64) {
+                this_thread::yield();
+            } else {
+                unique_lock<mutex> lock(_sleepLock);
+                _idle.fetch_add(1);
+                if (_running.load())
+                    _sleep.wait_for(lock, chrono::milliseconds(1));
+                _idle.fetch_sub(1);
+                misses = 0;
+            }
+        }
+    }
+
+    // member variable (fields)
+    Vector<WorkStealingDeque<Task*>*> _deques;  // One per worker, same index
+    Vector<thread*> _workers;
+    WorkStealingDeque<Task*> _injected;         // Tasks forked from outside
+    mutex _injectLock;                          // Held while pushing to _injected
+    mutex _sleepLock;
+    condition_variable _sleep;
+    atomic<int> _idle{0};                       // Workers asleep on _sleep
+    atomic<bool> _running;
+
+    inline static thread_local TaskScheduler* _current = nullptr; // Pool of the calling worker
+    inline static thread_local int _index = -1;                    // Its deque in that pool
+};
+
+
+#endif // _taskscheduler_h
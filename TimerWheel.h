@@ -0,0 +1,294 @@
+#ifndef _timerwheel_h
+#define _timerwheel_h
+
+#include <iostream>
+#include <climits>
+#include "Vector.h"
+
+using namespace std;
+
+/**
+ * This class models a hierarchical timing wheel: a delay queue in which
+ * every value is scheduled to come out after a number of ticks.  Level 0
+ * has one slot per tick, and each level above it has slots that are
+ * <code>2^bits</code> times wider.  A timer sits in the finest slot
+ * that covers its expiry, and it moves down one level each time the
+ * wheel turns past the start of its slot.
+ *
+ * <code>schedule</code> and <code>cancel</code> are O(1), and each
+ * tick of <code>advance</code> costs O(1) plus the timers it fires or
+ * moves down.  The wheel never reads a clock.  The caller decides what
+ * a tick is and when time passes, so tests are fully deterministic.
+ *
+ * Timers live in a pool held in a <code>Vector</code>.  Each slot is a
+ * doubly linked chain through that pool, linked by index rather than by
+ * pointer, so cancelling a timer never has to search for it.
+ */
+template <typename type>
+class TimerWheel {
+public:
+    ///  constructors and destructor
+
+    /**
+    *  Initializes a new empty wheel at time 0 with <code>levels</code>
+    *  levels of <code>2^bits</code> slots each.  Timers further away than
+    *  <code>2^(bits * levels)</code> ticks are parked in the top level
+    *  until they come into range.
+    *  @throw "Exception" if <code>bits</code> or <code>levels</code> is
+    *         less then 1, <code>bits</code> is more than 30, together they
+    *         cover more than 62 bits, or the slots of all levels do not
+    *         fit in an int
+    */
+    TimerWheel(int bits = 8, int levels = 4) {
+        if (bits < 1 || levels < 1 || bits > 30 || (long long)bits * levels > 62)
+            throw "Exception :-(";
+        if ((1LL << bits) * levels + 1 > INT_MAX)
+            throw "Exception :-(";
+        _bits = bits;
+        _levels = levels;
+        _slots = 1 << bits;
+        _now = 0;
+        _count = 0;
+        _free = -1;
+        Vector<int> heads(_slots * levels + 1, -1);
+        _heads.swap(heads);
+    }
+
+    /**
+    *  Frees any heap storage associated with this wheel.
+    */
+    virtual ~TimerWheel() = default;
+
+    ///  member function (methods)
+
+    /**
+    *  Schedules <code>value</code> to fire <code>delay</code> ticks from
+    *  now and returns a handle that can be passed to <code>cancel</code>.
+    *  The handle is opaque and may be negative.
+    *  A delay less then 1 fires on the next tick.
+    */
+    long long schedule(const type& value, long long delay) {
+        if (delay < 1)
+            delay = 1;
+
+        int index = allocate();
+        _entries[index].value = value;
+        _entries[index].expiry = _now + delay;
+        link(index, bucketFor(_entries[index].expiry, _now + 1));
+        _count++;
+        unsigned long long handle = (unsigned long long)_entries[index].generation << 32 | (unsigned)index;
+        return (long long)handle;
+    }
+
+    /**
+    *  Cancels the timer with the given handle.  Returns <code>false</code>
+    *  if it already fired or was already cancelled.
+    */
+    bool cancel(long long handle) {
+        int index = (int)(handle & 0xffffffffLL);
+        unsigned generation = (unsigned)((unsigned long long)handle >> 32);
+        if (index < 0 || index >= _entries.size())
+            return false;
+        if (_entries[index].bucket < 0 || _entries[index].generation != generation)
+            return false;
+
+        unlink(index);
+        release(index);
+        _count--;
+        return true;
+    }
+
+    /**
+    *  Moves time forward by <code>ticks</code> and calls
+    *  <code>fn(value)</code> for every timer that expires, tick by
+    *  tick.  The callback may schedule or cancel timers.  Returns the
+    *  number of timers fired.
+    */
+    template <typename Fn>
+    int advance(long long ticks, Fn fn) {
+        return advanceTo(_now + ticks, fn);
+    }
+
+    /**
+    *  Moves time forward by <code>ticks</code> and returns the values of
+    *  every timer that expired, tick by tick.
+    */
+    Vector<type> advance(long long ticks) {
+        Vector<type> fired;
+        advance(ticks, [&fired](const type& value) { fired.push_back(value); });
+        return fired;
+    }
+
+    /**
+    *  Moves time forward to <code>time</code>, as <code>advance</code>
+    *  does.  Earlier times are ignored.
+    */
+    template <typename Fn>
+    int advanceTo(long long time, Fn fn) {
+        int fired = 0;
+        while (_now < time) {
+            if (_count == 0) {              /// nothing to fire, jump ahead
+                _now = time;
+                break;
+            }
+            fired += tick(fn);
+        }
+        return fired;
+    }
+
+    /**
+    *  Returns the current time in ticks.
+    */
+    long long now() const {
+        return _now;
+    }
+
+    /**
+    *  Returns the number of pending timers.
+    */
+    int size() const {
+        return _count;
+    }
+
+    /**
+    *  Returns <code>true</code> if no timers are pending.
+    */
+    bool empty() const {
+        return _count == 0;
+    }
+
+    /**
+    *  Cancels every pending timer.  The time is left unchanged.
+    */
+    void clear() {
+        for (int i = 0; i < _heads.size(); i++) {
+            while (_heads[i] != -1) {
+                int index = _heads[i];
+                unlink(index);
+                release(index);
+            }
+        }
+        _count = 0;
+    }
+
+private:
+    /**
+    *  A timer in the pool.  <code>bucket</code> is -1 while the entry is
+    *  on the free list, where <code>next</code> links the free entries.
+    */
+    struct Entry {
+        type value;
+        long long expiry = 0;
+        int prev = -1;
+        int next = -1;
+        int bucket = -1;
+        unsigned generation = 1;
+    };
+
+    /**
+    *  Returns the bucket for a timer expiring at <code>expiry</code>, given
+    *  that <code>base</code> is the next tick to be processed.
+    */
+    int bucketFor(long long expiry, long long base) const {
+        long long distance = expiry - base;
+        for (int level = 0; level < _levels; level++) {
+            if (distance < (1LL << (_bits * (level + 1))))
+                return level * _slots + (int)((expiry >> (_bits * level)) & (_slots - 1));
+        }
+        int top = _levels - 1;                      /// out of range, park it
+        long long parked = base + (1LL << (_bits * _levels)) - 1;
+        return top * _slots + (int)((parked >> (_bits * top)) & (_slots - 1));
+    }
+
+    /**
+    *  Processes the next tick: moves down the timers of every higher level
+    *  slot that starts here, then fires the level 0 slot.
+    */
+    template <typename Fn>
+    int tick(Fn& fn) {
+        long long time = _now + 1;
+        for (int level = 1; level < _levels; level++) {
+            if ((time & ((1LL << (_bits * level)) - 1)) != 0)
+                break;
+            int bucket = level * _slots + (int)((time >> (_bits * level)) & (_slots - 1));
+            while (_heads[bucket] != -1) {
+                int index = _heads[bucket];
+                unlink(index);
+                link(index, bucketFor(_entries[index].expiry, time));
+            }
+        }
+
+        int firing = _slots * _levels;              /// detach the slot first
+        int bucket = (int)(time & (_slots - 1));
+        while (_heads[bucket] != -1) {
+            int index = _heads[bucket];
+            unlink(index);
+            link(index, firing);
+        }
+
+        _now = time;
+        int fired = 0;
+        while (_heads[firing] != -1) {
+            int index = _heads[firing];
+            unlink(index);
+            type value = _entries[index].value;
+            release(index);
+            _count--;
+            fired++;
+            fn(value);
+        }
+        return fired;
+    }
+
+    int allocate() {
+        if (_free == -1) {
+            _entries.push_back(Entry());
+            return _entries.size() - 1;
+        }
+        int index = _free;
+        _free = _entries[index].next;
+        return index;
+    }
+
+    void release(int index) {
+        _entries[index].value = type();
+        _entries[index].bucket = -1;
+        _entries[index].generation++;
+        _entries[index].next = _free;
+        _free = index;
+    }
+
+    void link(int index, int bucket) {
+        Entry& entry = _entries[index];
+        entry.bucket = bucket;
+        entry.prev = -1;
+        entry.next = _heads[bucket];
+        if (entry.next != -1)
+            _entries[entry.next].prev = index;
+        _heads[bucket] = index;
+    }
+
+    void unlink(int index) {
+        Entry& entry = _entries[index];
+        if (entry.prev != -1)
+            _entries[entry.prev].next = entry.next;
+        else
+            _heads[entry.bucket] = entry.next;
+        if (entry.next != -1)
+            _entries[entry.next].prev = entry.prev;
+        entry.prev = entry.next = -1;
+    }
+
+    // member variable (fields)
+    Vector<Entry> _entries;       // Timer pool, indexed by handle
+    Vector<int> _heads;           // First entry of each slot, plus the firing list
+    int _bits;
+    int _levels;
+    int _slots;                   // Slots per level, 2^_bits
+    int _free;                    // First entry of the free list
+    int _count;                   // Pending timers
+    long long _now;
+};
+
+
+#endif // _timerwheel_h
@@ -4,8 +4,41 @@
 #include <iostream>
 #include <string>
 #include <initializer_list>
+#include <utility>
+#include <new>
+#include <type_traits>
 using namespace std;
 
+/**
+ * The default storage policy of the containers: every block of
+ * <code>count</code> elements is one <code>new type[count]()</code>.
+ * An allocator hands out blocks of value-initialized elements and destroys
+ * them again; see <code>ArenaAllocator</code> in StackArena.h for one that
+ * draws its memory from a <code>StackArena</code>.  Its <code>rebind</code>
+ * gives the same allocator for another type, which LinkedList uses for
+ * its nodes.
+ */
+template <typename type>
+struct HeapAllocator {
+    template <typename otherType>
+    struct rebind {
+        typedef HeapAllocator<otherType> other;
+    };
+
+    HeapAllocator() { }
+
+    template <typename otherType>
+    HeapAllocator(const HeapAllocator<otherType>&) { }
+
+    type* allocate(int count) {
+        return new type[count]();
+    }
+
+    void deallocate(type* block, int /*count*/) {
+        delete[] block;
+    }
+};
+
 /**
  * This class stores an ordered list of values similar to an array.
  * It supports traditional array selection using square brackets, but
@@ -13,7 +46,7 @@ using namespace std;
  * function to the STL <code>vector</code> type, but is simpler both
  * to use and to implement.
  */
-template <typename type>
+template <typename type, typename Alloc = HeapAllocator<type> >
 class Vector {
 public:
     ///  constructors and destructor
@@ -36,6 +69,12 @@ public:
     */
     Vector(int size, type value);
 
+    /**
+    *  Initialization of new empty Vector that takes its storage from
+    *  <code>alloc</code>
+    */
+    Vector(const Alloc& alloc);
+
     /**
     *  Copy Constructor - use the passed Vector to initialization itself (deep copy)
     */
@@ -59,6 +98,22 @@ public:
     *  add a new value to the end of the Vector
     */
     void push_back(const type& value);
+    void push_back(type&& value);
+
+    /**
+    *  build a new value from <code>args</code> directly in the slot at the
+    *  end of the Vector.  A value whose constructor may throw is built
+    *  aside and moved in instead, so a throw leaves the Vector unchanged
+    */
+    template <typename... Args>
+    void emplace_back(Args&&... args);
+
+    /**
+    *  add <code>count</code> values from <code>values</code> to the end of
+    *  the Vector, growing the storage at most once
+    *  @throw "Exception" if <code>count</code> is less then 0
+    */
+    void push_back(const type* values, int count);
 
     /**
     *  add a new value to the start of the Vector
@@ -71,6 +126,13 @@ public:
     */
     void pop_back();
 
+    /**
+    *  remove <code>count</code> values from the end of the Vector and move
+    *  them into <code>values</code>, last element first
+    *  @throw "Exception" if <code>count</code> is less then 0 or more than size
+    */
+    void pop_back(type* values, int count);
+
     /**
     *  remove a value from the start of the Vector
     *  @throw "Exception" if Vector is empty
@@ -137,6 +199,12 @@ public:
     */
     int capacity() const;
 
+    /**
+    *  grow the storage so that it can hold at least <code>capacity</code>
+    *  elements without reallocating
+    */
+    void reserve(int capacity);
+
     /**
     *  return value of first element of Vector
     *  @throw "Exception" if Vector is empty
@@ -264,11 +332,11 @@ public:
     */
     Vector operator-();
 
-    template <typename T>
-    friend ostream& operator<<(ostream& out, Vector<T>& list);
+    template <typename T, typename A>
+    friend ostream& operator<<(ostream& out, Vector<T, A>& list);
 
-    template <typename T>
-    friend ostream& operator<<(ostream& out, const Vector<T>& list);
+    template <typename T, typename A>
+    friend ostream& operator<<(ostream& out, const Vector<T, A>& list);
 
 
 
@@ -277,31 +345,32 @@ private:
     type* _Vector;
     int _size;
     int _capacity;
+    Alloc _alloc;
 };
 
 /** Implementation Section */
 
-template <typename type>
-Vector<type>::Vector() {
-    _Vector = new type[1]();
+template <typename type, typename Alloc>
+Vector<type, Alloc>::Vector() {
+    _Vector = _alloc.allocate(1);
     _size = 0;
     _capacity = 1;
 }
 
-template <typename type>
-Vector<type>::Vector(int size) {
+template <typename type, typename Alloc>
+Vector<type, Alloc>::Vector(int size) {
     if (size < 0)
         throw "Exception :-(";
-    _Vector = new type[size]();
+    _Vector = _alloc.allocate(size);
     _size = size;
     _capacity = size;
 }
 
-template <typename type>
-Vector<type>::Vector(int size, type value) {
+template <typename type, typename Alloc>
+Vector<type, Alloc>::Vector(int size, type value) {
     if (size < 0)
         throw "Exception :-(";
-    _Vector = new type[size];
+    _Vector = _alloc.allocate(size);
 
     for (int i = 0; i < size; i++)
         _Vector[i] = value;
@@ -310,128 +379,172 @@ Vector<type>::Vector(int size, type value) {
     _capacity = size;
 }
 
-template <typename type>
-Vector<type>::Vector(const Vector& list) {
+template <typename type, typename Alloc>
+Vector<type, Alloc>::Vector(const Alloc& alloc) : _alloc(alloc) {
+    _Vector = _alloc.allocate(1);
+    _size = 0;
+    _capacity = 1;
+}
+
+template <typename type, typename Alloc>
+Vector<type, Alloc>::Vector(const Vector& list) : _alloc(list._alloc) {
     _size = list._size;
     _capacity = list.capacity();
-    _Vector = new type[_capacity];
+    _Vector = _alloc.allocate(_capacity);
 
     for (int i = 0; i < _size; i++)
         _Vector[i] = list._Vector[i];
 }
 
-template <typename type>
-Vector<type>::Vector(Vector&& list) {
+template <typename type, typename Alloc>
+Vector<type, Alloc>::Vector(Vector&& list) : _alloc(list._alloc) {
     _size = list._size;
     _capacity = list.capacity();
     _Vector = list._Vector;
     list._Vector = nullptr;
+    list._size = 0;
+    list._capacity = 0;
 }
 
-template <typename type>
-Vector<type>::Vector(initializer_list<type> list) {
-    _Vector = new type[1]();
+template <typename type, typename Alloc>
+Vector<type, Alloc>::Vector(initializer_list<type> list) {
+    _Vector = _alloc.allocate(1);
     _size = 0;
     _capacity = 1;
     for (type i : list)
         push_back(i);
 }
 
-template <typename type>
-Vector<type>::~Vector() {
-    delete[] _Vector;
+template <typename type, typename Alloc>
+Vector<type, Alloc>::~Vector() {
+    _alloc.deallocate(_Vector, _capacity);
 }
 
-template <typename type>
-void Vector<type>::push_back(const type& value) {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::push_back(const type& value) {
     insert(_size, value);
 }
 
-template <typename type>
-void Vector<type>::push_front(const type& value) {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::push_back(type&& value) {
+    if (_capacity == _size)
+        reserve(_capacity > 0 ? 2 * _capacity : 1);
+    _Vector[_size++] = std::move(value);
+}
+
+template <typename type, typename Alloc>
+template <typename... Args>
+void Vector<type, Alloc>::emplace_back(Args&&... args) {
+    if (_capacity == _size)
+        reserve(_capacity > 0 ? 2 * _capacity : 1);
+    if constexpr (is_nothrow_constructible<type, Args&&...>::value) {
+        type* slot = _Vector + _size;           /// free slots hold default values
+        slot->~type();
+        new (slot) type(std::forward<Args>(args)...);
+    } else {
+        _Vector[_size] = type(std::forward<Args>(args)...);
+    }
+    _size++;
+}
+
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::push_back(const type* values, int count) {
+    if (count < 0)
+        throw "Exception :-(";
+    if (_size + count > _capacity)
+        reserve(_size + count > 2 * _capacity ? _size + count : 2 * _capacity);
+    for (int i = 0; i < count; i++)
+        _Vector[_size + i] = values[i];
+    _size += count;
+}
+
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::push_front(const type& value) {
     insert(0, value);
 }
 
-template <typename type>
-void Vector<type>::pop_back() {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::pop_back() {
     if (_Vector == nullptr)
         throw "Exception :-(";
     remove(_size);
 }
 
-template <typename type>
-void Vector<type>::pop_front() {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::pop_back(type* values, int count) {
+    if (count < 0 || count > _size)
+        throw "Exception :-(";
+    for (int i = 0; i < count; i++)
+        values[i] = std::move(_Vector[_size - 1 - i]);
+    _size -= count;
+}
+
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::pop_front() {
     if (_Vector == nullptr)
         throw "Exception :-(";
     remove(0);
 }
 
-template <typename type>
-void Vector<type>::clear() {
-    delete[] _Vector;
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::clear() {
+    _alloc.deallocate(_Vector, _capacity);
     _size = 0;
     _capacity = 1;
-    _Vector = new type[1]();
+    _Vector = _alloc.allocate(1);
 }
 
-template <typename type>
-bool Vector<type>::equals(const Vector<type>& list) const {
+template <typename type, typename Alloc>
+bool Vector<type, Alloc>::equals(const Vector<type, Alloc>& list) const {
     return operator==(list);
 }
 
-template <typename type>
-type Vector<type>::at(int index) const {
+template <typename type, typename Alloc>
+type Vector<type, Alloc>::at(int index) const {
     return _Vector[index];
 }
 
-template <typename type>
-int Vector<type>::contain(const type& value) const {
+template <typename type, typename Alloc>
+int Vector<type, Alloc>::contain(const type& value) const {
     for (int i = 0; i < _size; i++)
         if (_Vector[i] == value)
             return i;
     return -1;
 }
 
-template <typename type>
-void Vector<type>::insert(int index, const type& value) {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::insert(int index, const type& value) {
     if (index > _size || index < 0)
         throw "Exception :-(";
     else {
-        if (_capacity == _size) {                       /// Check of your Vector is too small
-            type* big = new type[2 * _capacity]();      ///then it increase to preferable size
-
-            for (int i = 0; i < _size; i++)
-                big[i] = _Vector[i];
+        if (_capacity == _size)                         /// Check of your Vector is too small
+            reserve(_capacity > 0 ? 2 * _capacity : 1); ///then it increase to preferable size
 
-            delete[] _Vector;
-            _Vector = big;
-            _capacity *= 2;
-        }
         for (int i = _size; i > index; i--)
-            _Vector[i] = _Vector[i - 1];
+            _Vector[i] = std::move(_Vector[i - 1]);
 
         _Vector[index] = value;
         _size++;
     }
 }
 
-template <typename type>
-bool Vector<type>::empty() const {
+template <typename type, typename Alloc>
+bool Vector<type, Alloc>::empty() const {
     return !_size;
 }
 
-template <typename type>
-void Vector<type>::remove(int index) {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::remove(int index) {
     if (index > _size || index < 0)
         throw "Exception :-(";
     else {
         if (_size == _capacity / 2) {           /// Check of your Vector is too big
-            type* small = new type[_size]();    ///then it shrink to preferable size
+            type* small = _alloc.allocate(_size);    ///then it shrink to preferable size
 
             for (int i = 0; i < _size; i++)
                 small[i] = _Vector[i];
 
-            delete[] _Vector;
+            _alloc.deallocate(_Vector, _capacity);
             _Vector = small;
             _capacity /= 2;
         }
@@ -443,53 +556,66 @@ void Vector<type>::remove(int index) {
     }
 }
 
-template <typename type>
-void Vector<type>::set(int index, const type& value) {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::set(int index, const type& value) {
     if(index < 0 || index + 1 > _size)
         throw "Exception :-(";
     _Vector[index] = value;
 }
 
-template <typename type>
-int Vector<type>::size() const {
+template <typename type, typename Alloc>
+int Vector<type, Alloc>::size() const {
     return _size;
 }
 
-template <typename type>
-int Vector<type>::capacity() const {
+template <typename type, typename Alloc>
+int Vector<type, Alloc>::capacity() const {
     return _capacity;
 }
 
-template <typename type>
-type& Vector<type>::front() {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::reserve(int capacity) {
+    if (capacity <= _capacity)
+        return;
+    type* big = _alloc.allocate(capacity);
+    for (int i = 0; i < _size; i++)
+        big[i] = std::move(_Vector[i]);
+
+    _alloc.deallocate(_Vector, _capacity);
+    _Vector = big;
+    _capacity = capacity;
+}
+
+template <typename type, typename Alloc>
+type& Vector<type, Alloc>::front() {
     if (_Vector == nullptr)
         throw "Exception :-(";
     return _Vector[0];
 }
 
-template <typename type>
-const type& Vector<type>::front() const {
+template <typename type, typename Alloc>
+const type& Vector<type, Alloc>::front() const {
     if (_Vector == nullptr)
         throw "Exception :-(";
     return _Vector[0];
 }
 
-template <typename type>
-type& Vector<type>::back() {
+template <typename type, typename Alloc>
+type& Vector<type, Alloc>::back() {
     if (_Vector == nullptr)
         throw "Exception :-(";
     return _Vector[_size - 1];
 }
 
-template <typename type>
-const type& Vector<type>::back() const {
+template <typename type, typename Alloc>
+const type& Vector<type, Alloc>::back() const {
     if (_Vector == nullptr)
         throw "Exception :-(";
     return _Vector[_size - 1];
 }
 
-template <typename type>
-void Vector<type>::swap(Vector& list) {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::swap(Vector& list) {
     type* temp = _Vector;
     int tempSize = _size;
     int tempCapacity = _capacity;
@@ -501,11 +627,12 @@ void Vector<type>::swap(Vector& list) {
     list._Vector = temp;
     list._size = tempSize;
     list._capacity = tempCapacity;
+    std::swap(_alloc, list._alloc);
 }
 
-template <typename type>
-Vector<type> Vector<type>::subList(int start, int length) {
-    Vector<type> list;
+template <typename type, typename Alloc>
+Vector<type, Alloc> Vector<type, Alloc>::subList(int start, int length) {
+    Vector<type, Alloc> list(_alloc);
     if (start > _size || start + length > _size || start < 0 || length < 0)
         throw "Exception :-(";
     else {
@@ -515,37 +642,37 @@ Vector<type> Vector<type>::subList(int start, int length) {
     return list;
 }
 
-template <typename type>
-Vector<type> Vector<type>::subList(int start) {
+template <typename type, typename Alloc>
+Vector<type, Alloc> Vector<type, Alloc>::subList(int start) {
     return subList(start, _size - start);
 }
 
-template <typename type>
-void Vector<type>::map(type (*fn)(type)) {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::map(type (*fn)(type)) {
     for (int i = 0; i < _size; i++)
         set(i, fn(at(i)));
 }
 
-template <typename type>
-void Vector<type>::map(type (*fn)(type&)) {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::map(type (*fn)(type&)) {
     for (int i = 0; i < _size; i++)
         set(i, fn(at(i)));
 }
 
-template <typename type>
-void Vector<type>::map(type (*fn)(const type&)) {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::map(type (*fn)(const type&)) {
     for (int i = 0; i < _size; i++)
         set(i, fn(at(i)));
 }
 
-template <typename type>
-void Vector<type>::addAll(const Vector& list) {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::addAll(const Vector& list) {
     for (int i = 0; i < list._size; i++)
         push_back(list.at(i));
 }
 
-template <typename type>
-void Vector<type>::addAll(int index, const Vector& list){
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::addAll(int index, const Vector& list){
     if (index > _size || index < 0)
         throw "Exception :-(";
     else
@@ -553,8 +680,8 @@ void Vector<type>::addAll(int index, const Vector& list){
             insert(index + i, list.at(i));
 }
 
-template <typename type>
-void Vector<type>::removeAll(int index, int length) {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::removeAll(int index, int length) {
     if (index > _size || index + length > _size || index < 0 || length < 0)
         throw "Exception :-(";
     else
@@ -562,13 +689,13 @@ void Vector<type>::removeAll(int index, int length) {
             remove(i);
 }
 
-template <typename type>
-void Vector<type>::removeAll(int index) {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::removeAll(int index) {
     removeAll(index, _size - index);
 }
 
-template <typename type>
-void Vector<type>::sort() {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::sort() {
     int temp;
     bool flag = true;
     for (int round = 1; round < _size; round++) {
@@ -587,29 +714,29 @@ void Vector<type>::sort() {
     }
 }
 
-template <typename type>
-type& Vector<type>::operator[](const int index) {
+template <typename type, typename Alloc>
+type& Vector<type, Alloc>::operator[](const int index) {
     if (index > _size || index < 0)
         throw "Exception :-(";
     else
         return _Vector[index];
 }
 
-template <typename type>
-const type& Vector<type>::operator[](int index) const {
+template <typename type, typename Alloc>
+const type& Vector<type, Alloc>::operator[](int index) const {
     if (index > _size || index < 0)
         throw "Exception :-(";
     else
         return _Vector[index];
 }
 
-template <typename type>
-Vector<type>& Vector<type>::operator=(Vector& list) {
+template <typename type, typename Alloc>
+Vector<type, Alloc>& Vector<type, Alloc>::operator=(Vector& list) {
     if (this != &list) {
-        delete[] _Vector;
+        _alloc.deallocate(_Vector, _capacity);
         _size = list._size;
         _capacity = list.capacity();
-        _Vector = new type[_capacity];
+        _Vector = _alloc.allocate(_capacity);
 
         for (int i = 0; i < _size; i++)
             _Vector[i] = list._Vector[i];
@@ -617,17 +744,23 @@ Vector<type>& Vector<type>::operator=(Vector& list) {
     return *this;
 }
 
-template <typename type>
-Vector<type>& Vector<type>::operator=(Vector&& list) {
-    _size = list._size;
-    _capacity = list.capacity();
-    _Vector = list._Vector;
-    list._Vector = nullptr;
+template <typename type, typename Alloc>
+Vector<type, Alloc>& Vector<type, Alloc>::operator=(Vector&& list) {
+    if (this != &list) {
+        _alloc.deallocate(_Vector, _capacity);
+        _alloc = list._alloc;
+        _size = list._size;
+        _capacity = list.capacity();
+        _Vector = list._Vector;
+        list._Vector = nullptr;
+        list._size = 0;
+        list._capacity = 0;
+    }
     return *this;
 }
 
-template <typename type>
-bool Vector<type>::operator==(const Vector& list) const {
+template <typename type, typename Alloc>
+bool Vector<type, Alloc>::operator==(const Vector& list) const {
     if (_size == list._size) {
         for (int i = 0; i < _size; i++) {
             if (!(_Vector[i] == list._Vector[i]))
@@ -638,13 +771,13 @@ bool Vector<type>::operator==(const Vector& list) const {
     return false;
 }
 
-template <typename type>
-bool Vector<type>::operator!=(const Vector& list) const {
+template <typename type, typename Alloc>
+bool Vector<type, Alloc>::operator!=(const Vector& list) const {
     return !(operator==(list));
 }
 
-template <typename type>
-bool Vector<type>::operator<(const Vector& list) const {
+template <typename type, typename Alloc>
+bool Vector<type, Alloc>::operator<(const Vector& list) const {
     if (_size == list._size) {
         for (int i = 0; i < _size; i++) {
             if (!(_Vector[i] < list._Vector[i]))
@@ -655,8 +788,8 @@ bool Vector<type>::operator<(const Vector& list) const {
     return false;
 }
 
-template <typename type>
-bool Vector<type>::operator<=(const Vector& list) const {
+template <typename type, typename Alloc>
+bool Vector<type, Alloc>::operator<=(const Vector& list) const {
     if (_size == list._size) {
         for (int i = 0; i < _size; i++) {
             if (!(_Vector[i] <= list._Vector[i]))
@@ -667,8 +800,8 @@ bool Vector<type>::operator<=(const Vector& list) const {
     return false;
 }
 
-template <typename type>
-bool Vector<type>::operator>(const Vector& list) const {
+template <typename type, typename Alloc>
+bool Vector<type, Alloc>::operator>(const Vector& list) const {
     if (_size == list._size) {
         for (int i = 0; i < _size; i++) {
             if (!(_Vector[i] > list._Vector[i]))
@@ -679,8 +812,8 @@ bool Vector<type>::operator>(const Vector& list) const {
     return false;
 }
 
-template <typename type>
-bool Vector<type>::operator>=(const Vector& list) const {
+template <typename type, typename Alloc>
+bool Vector<type, Alloc>::operator>=(const Vector& list) const {
     if (_size == list._size) {
         for (int i = 0; i < _size; i++) {
             if (!(_Vector[i] >= list._Vector[i]))
@@ -691,9 +824,9 @@ bool Vector<type>::operator>=(const Vector& list) const {
     return false;
 }
 
-template <typename type>
-Vector<type> Vector<type>::operator+(Vector& list) {
-    Vector<type> list1;
+template <typename type, typename Alloc>
+Vector<type, Alloc> Vector<type, Alloc>::operator+(Vector& list) {
+    Vector<type, Alloc> list1(_alloc);
 
     list1.addAll(subList(0));
     list1.addAll(list.subList(0));
@@ -701,9 +834,9 @@ Vector<type> Vector<type>::operator+(Vector& list) {
     return list1;
 }
 
-template <typename type>
-Vector<type> Vector<type>::operator+(const type& value) {
-    Vector<type> list1;
+template <typename type, typename Alloc>
+Vector<type, Alloc> Vector<type, Alloc>::operator+(const type& value) {
+    Vector<type, Alloc> list1(_alloc);
 
     list1.addAll(subList(0));
     list1.push_back(value);
@@ -711,19 +844,19 @@ Vector<type> Vector<type>::operator+(const type& value) {
     return list1;
 }
 
-template <typename type>
-void Vector<type>::operator+=(const Vector& list) {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::operator+=(const Vector& list) {
     addAll(list);
 }
 
-template <typename type>
-void Vector<type>::operator+=(const type& value) {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::operator+=(const type& value) {
     push_back(value);
 }
 
-template <typename type>
-Vector<type> Vector<type>::operator-(const type& value) {
-    Vector<type> list1;
+template <typename type, typename Alloc>
+Vector<type, Alloc> Vector<type, Alloc>::operator-(const type& value) {
+    Vector<type, Alloc> list1(_alloc);
 
     list1.addAll(subList(0));
 
@@ -734,15 +867,15 @@ Vector<type> Vector<type>::operator-(const type& value) {
     return list1;
 }
 
-template <typename type>
-void Vector<type>::operator-=(const type& value) {
+template <typename type, typename Alloc>
+void Vector<type, Alloc>::operator-=(const type& value) {
     if (contain(value) != -1)
         remove(contain(value));
 }
 
-template <typename type>
-Vector<type> Vector<type>::operator-() {
-    Vector<type> list1;
+template <typename type, typename Alloc>
+Vector<type, Alloc> Vector<type, Alloc>::operator-() {
+    Vector<type, Alloc> list1(_alloc);
 
     for (int i = 0; i < _size; i++)
         list1.push_back(-at(i));
@@ -751,8 +884,8 @@ Vector<type> Vector<type>::operator-() {
 }
 
 
-template <typename type>
-ostream& operator<<(ostream& out, Vector<type>& list) {
+template <typename type, typename Alloc>
+ostream& operator<<(ostream& out, Vector<type, Alloc>& list) {
     out << "{ ";
     for (int i = 0; i < list.size(); i++) {
             if (i == list.size() - 1)
@@ -764,8 +897,8 @@ ostream& operator<<(ostream& out, Vector<type>& list) {
     return out;
 }
 
-template <typename type>
-ostream& operator<<(ostream& out, const Vector<type>& list) {
+template <typename type, typename Alloc>
+ostream& operator<<(ostream& out, const Vector<type, Alloc>& list) {
     out << "{ ";
     for (int i = 0; i < list.size(); i++) {
             if (i == list.size() - 1)
@@ -0,0 +1,204 @@
+#ifndef _workstealingdeque_h
+#define _workstealingdeque_h
+
+#include <atomic>
+#include <type_traits>
+#include "Vector.h"
+
+using namespace std;
+
+/**
+ * This class models a Chase-Lev work-stealing deque.  One thread, the
+ * owner, adds and removes values at the bottom with <code>push</code>
+ * and <code>pop</code> (last-in/first-out), while any number of other
+ * threads, the thieves, take the oldest values from the top with
+ * <code>steal</code>.  The values live in a growable circular array, so
+ * the owner never blocks and a thief only contends when it races for
+ * the same value.
+ *
+ * Slots are read and written atomically, so <code>type</code> must be
+ * trivially copyable; in practice it is a pointer to a task.
+ */
+template <typename type>
+class WorkStealingDeque {
+public:
+    ///  constructors and destructor
+
+    /**
+    *  Initializes a new empty deque that can hold <code>capacity</code>
+    *  values before it grows.  The capacity is rounded up to a power of two.
+    */
+    WorkStealingDeque(int capacity = 64) {
+        long size = 1;
+        while (size < capacity)
+            size *= 2;
+        _array.store(new CircularArray(size), memory_order_relaxed);
+        _top.store(0, memory_order_relaxed);
+        _bottom.store(0, memory_order_relaxed);
+    }
+
+    /**
+    *  The deque is shared between threads by address, so it can not be
+    *  copied or moved.
+    */
+    WorkStealingDeque(const WorkStealingDeque& deque) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque& deque) = delete;
+
+    /**
+    *  Frees the circular array and every array that it has outgrown.
+    */
+    virtual ~WorkStealingDeque() {
+        delete _array.load(memory_order_relaxed);
+        for (int i = 0; i < _retired.size(); i++)
+            delete _retired[i];
+    }
+
+    ///  member function (methods)
+
+    /**
+    *  Adds <code>value</code> to the bottom of the deque, doubling the
+    *  circular array if it is full.  Only the owner thread may call this.
+    */
+    void push(const type& value) {
+        long bottom = _bottom.load(memory_order_relaxed);
+        long top = _top.load(memory_order_acquire);
+        CircularArray* array = _array.load(memory_order_relaxed);
+
+        if (bottom - top > array->capacity - 1) {
+            array = grow(array, top, bottom);
+        }
+        array->put(bottom, value);
+        _bottom.store(bottom + 1, memory_order_release);     /// publishes the slot to steal
+    }
+
+    /**
+    *  Removes the value at the bottom of the deque and stores it in
+    *  <code>value</code>.  Returns <code>false</code> if the deque is
+    *  empty or a thief took the last value first.
+    *  Only the owner thread may call this.
+    */
+    bool pop(type& value) {
+        long bottom = _bottom.load(memory_order_relaxed) - 1;
+        CircularArray* array = _array.load(memory_order_relaxed);
+        _bottom.store(bottom, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        long top = _top.load(memory_order_relaxed);
+
+        if (top > bottom) {                         /// already empty
+            _bottom.store(bottom + 1, memory_order_relaxed);
+            return false;
+        }
+
+        value = array->get(bottom);
+        if (top == bottom) {                        /// last value, race the thieves
+            bool won = _top.compare_exchange_strong(top, top + 1,
+                                                    memory_order_seq_cst,
+                                                    memory_order_relaxed);
+            _bottom.store(bottom + 1, memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+    *  Removes the value at the top of the deque and stores it in
+    *  <code>value</code>.  Returns <code>false</code> if the deque is
+    *  empty or another thread took the value first.
+    *  Any thread may call this.
+    */
+    bool steal(type& value) {
+        long top = _top.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        long bottom = _bottom.load(memory_order_acquire);
+
+        if (top >= bottom)
+            return false;
+
+        CircularArray* array = _array.load(memory_order_acquire);
+        type element = array->get(top);
+        if (!_top.compare_exchange_strong(top, top + 1,
+                                          memory_order_seq_cst,
+                                          memory_order_relaxed))
+            return false;
+        value = element;
+        return true;
+    }
+
+    /**
+    *  Returns <code>true</code> if the deque holds no values.  The answer
+    *  may be stale by the time it is used if other threads are active.
+    */
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+    *  Returns the number of values in the deque at some recent moment.
+    */
+    int size() const {
+        long bottom = _bottom.load(memory_order_relaxed);
+        long top = _top.load(memory_order_relaxed);
+        return bottom > top ? (int)(bottom - top) : 0;
+    }
+
+    /**
+    *  Returns the number of values the deque can hold before it grows.
+    */
+    int capacity() const {
+        return (int)_array.load(memory_order_relaxed)->capacity;
+    }
+
+private:
+    static_assert(is_trivially_copyable<type>::value,
+                  "WorkStealingDeque requires a trivially copyable type");
+
+    /**
+    *  A power-of-two ring of atomic slots indexed by the ever-growing
+    *  top and bottom counters.
+    */
+    struct CircularArray {
+        long capacity;
+        long mask;
+        atomic<type>* slots;
+
+        CircularArray(long size) {
+            capacity = size;
+            mask = size - 1;
+            slots = new atomic<type>[size];
+        }
+
+        ~CircularArray() {
+            delete[] slots;
+        }
+
+        type get(long index) const {
+            return slots[index & mask].load(memory_order_relaxed);
+        }
+
+        void put(long index, const type& value) {
+            slots[index & mask].store(value, memory_order_relaxed);
+        }
+    };
+
+    /**
+    *  Copies the live range into an array twice as big.  Thieves may still
+    *  be reading the old array, so it is retired instead of freed.
+    */
+    CircularArray* grow(CircularArray* array, long top, long bottom) {
+        CircularArray* bigger = new CircularArray(array->capacity * 2);
+        for (long i = top; i < bottom; i++)
+            bigger->put(i, array->get(i));
+        _retired.push_back(array);
+        _array.store(bigger, memory_order_release);
+        return bigger;
+    }
+
+    // member variable (fields)
+    atomic<long> _top;                      // Next index a thief steals from
+    atomic<long> _bottom;                   // Next index the owner pushes to
+    atomic<CircularArray*> _array;
+    Vector<CircularArray*> _retired;        // Outgrown arrays, owner only
+};
+
+
+#endif // _workstealingdeque_h